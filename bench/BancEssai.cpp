@@ -0,0 +1,407 @@
+/**
+ * @file BancEssai.cpp
+ * @brief Banc d'essai de précision et de débit des moteurs de corrélation, sur des prises de vue synthétiques.
+ *
+ * Une scène sonore synthétique est générée localement, puis « filmée » par une caméra de référence et
+ * une caméra cible avec un décalage connu, du bruit, un gain, une dérive d'horloge ou une prise plus courte.
+ * Chaque moteur de calculerDecalage est mesuré sur chaque prise, pour plusieurs durées d'analyse, plages
+ * de recherche et pas : erreur en échantillons par rapport au décalage réel, temps, et débit
+ * (échantillons d'entrée, échantillons corrélés et retards évalués par seconde).
+ *
+ * Débits : « Méch/s » compte les échantillons fournis, « Mcorr/s » les échantillons de référence corrélés
+ * et « Mretards/s » les retards évalués, relevés par les compteurs de Metriques.
+ *
+ * Usage : BancSynchro [--rapide] [--repetitions N] [--csv fichier.csv]
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/SynchroniseurMultiVideo.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <numbers>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct Prise
+ * @brief Conditions de tournage de la caméra cible par rapport à la référence.
+ */
+struct Prise {
+    string nom; /**< Nom affiché. */
+    double retard; /**< Décalage réel de la cible (en secondes, fractionnaire). */
+    double rapportSignalBruit; /**< Bruit blanc ajouté à la cible (en dB, infini pour aucun). */
+    double gain; /**< Gain appliqué à la cible. */
+    double derive; /**< Dérive de l'horloge de la cible (secondes gagnées par seconde). */
+    double proportionDuree; /**< Durée de la cible rapportée à la durée analysée. */
+};
+
+/**
+ * @struct Resultat
+ * @brief Mesure d'un moteur sur une prise.
+ */
+struct Resultat {
+    string moteur; /**< Moteur et pas. */
+    string prise; /**< Nom de la prise. */
+    double duree; /**< Durée d'analyse (en secondes). */
+    double plage; /**< Plage de recherche (en secondes). */
+    double erreur; /**< Erreur absolue (en échantillons, infinie si aucun retard n'a été trouvé). */
+    double rapportPicLobes; /**< Netteté du pic trouvé. */
+    double plageExploree; /**< Demi-largeur de la plage réellement parcourue (en secondes). */
+    double secondes; /**< Meilleur temps de calcul sur les répétitions. */
+    double echantillonsEntree; /**< Échantillons de référence et de cible fournis au moteur. */
+    Metriques::Compteurs travail; /**< Échantillons corrélés et retards évalués. */
+};
+
+/**
+ * @class BancEssai
+ * @brief Génère les prises synthétiques et mesure chaque moteur (classe amie de SynchroniseurMultiVideo).
+ */
+class BancEssai {
+    /**
+     * @brief Marge de la scène avant le début de la référence (en secondes), qui couvre les retards positifs.
+     */
+    static constexpr double MARGE = 60.0;
+
+    /**
+     * @brief Synchroniseur dont les moteurs sont mesurés.
+     */
+    SynchroniseurMultiVideo synchro;
+
+    /**
+     * @brief Fréquence d'échantillonnage de l'analyse (en Hz).
+     */
+    const int frequence;
+
+    /**
+     * @brief Scène sonore continue, dont les caméras enregistrent des portions.
+     */
+    vector<float> scene;
+
+    /**
+     * @brief Nombre de répétitions de chaque mesure (le meilleur temps est retenu).
+     */
+    int repetitions;
+
+    /**
+     * @brief Génère une scène : bruit de fond coloré, notes harmoniques à enveloppe décroissante et claquements.
+     */
+    static vector<float> genererScene(double duree, int frequence, uint32_t graine) {
+        mt19937 generateur(graine);
+        normal_distribution<float> gauss(0.0f, 1.0f);
+        uniform_real_distribution<double> uniforme(0.0, 1.0);
+
+        vector<float> signal(static_cast<size_t>(duree * frequence));
+
+        // Bruit de fond rose approximé par un filtre du premier ordre.
+        float fond = 0.0f;
+        for (float &echantillon: signal) {
+            fond = 0.97f * fond + 0.03f * gauss(generateur);
+            echantillon = 0.3f * fond + 0.01f * gauss(generateur);
+        }
+
+        // Notes : fondamentale et deux harmoniques, attaque franche et décroissance exponentielle.
+        for (double instant = 0.0; instant < duree; instant += 0.1 + 0.3 * uniforme(generateur)) {
+            const double f0 = 150.0 * pow(20.0, uniforme(generateur));
+            const double amplitude = 0.2 + 0.4 * uniforme(generateur);
+            const double decroissance = 0.08 + 0.3 * uniforme(generateur);
+            const auto debut = static_cast<size_t>(instant * frequence);
+            const auto fin = min(signal.size(), debut + static_cast<size_t>(4.0 * decroissance * frequence));
+
+            for (size_t i = debut; i < fin; ++i) {
+                const double t = static_cast<double>(i - debut) / frequence;
+                const double enveloppe = amplitude * exp(-t / decroissance);
+                const double phase = 2.0 * numbers::pi * f0 * t;
+
+                signal[i] += static_cast<float>(enveloppe * (sin(phase) + 0.5 * sin(2.0 * phase)
+                                                             + 0.25 * sin(3.0 * phase)));
+            }
+
+            // Claquement occasionnel : impulsion large bande.
+            if (uniforme(generateur) < 0.1) {
+                for (size_t i = debut; i < min(signal.size(), debut + 64); ++i) signal[i] += 0.8f * gauss(generateur);
+            }
+        }
+
+        return signal;
+    }
+
+    /**
+     * @brief Lit la scène à une position fractionnaire (interpolation linéaire, silence hors de la scène).
+     */
+    float lire(double position) const {
+        if (position < 0.0 || position + 1.0 >= static_cast<double>(scene.size())) return 0.0f;
+
+        const auto indice = static_cast<size_t>(position);
+        const auto fraction = static_cast<float>(position - indice);
+
+        return scene[indice] + fraction * (scene[indice + 1] - scene[indice]);
+    }
+
+    /**
+     * @brief Filme la référence et la cible d'une prise.
+     *
+     * La référence enregistre la scène à partir de MARGE ; la cible vérifie cible[i + retard] = ref[i]
+     * à l'instant 0, puis avance de (1 + derive) échantillons de scène par échantillon.
+     *
+     * @return Le décalage réel au centre de la référence (en échantillons).
+     */
+    double filmer(const Prise &prise, double duree, vector<float> &ref, vector<float> &cible) const {
+        const double debutRef = MARGE * frequence;
+        const double retard = prise.retard * frequence;
+
+        ref.resize(static_cast<size_t>(duree * frequence));
+        for (size_t i = 0; i < ref.size(); ++i) ref[i] = lire(debutRef + static_cast<double>(i));
+
+        cible.resize(static_cast<size_t>(duree * prise.proportionDuree * frequence));
+        for (size_t j = 0; j < cible.size(); ++j) {
+            cible[j] = static_cast<float>(prise.gain) * lire(debutRef - retard + j * (1.0 + prise.derive));
+        }
+
+        if (isfinite(prise.rapportSignalBruit)) {
+            double puissance = 0.0;
+            for (const float echantillon: cible) puissance += static_cast<double>(echantillon) * echantillon;
+            puissance /= max<size_t>(1, cible.size());
+
+            const double ecartType = sqrt(puissance / pow(10.0, prise.rapportSignalBruit / 10.0));
+
+            mt19937 generateur(42);
+            normal_distribution<double> gauss(0.0, ecartType);
+            for (float &echantillon: cible) echantillon += static_cast<float>(gauss(generateur));
+        }
+
+        // Avec une dérive, le décalage varie : la référence de l'erreur est prise au centre de la référence.
+        const double centre = ref.size() / 2.0;
+        return (centre + retard) / (1.0 + prise.derive) - centre;
+    }
+
+    /**
+     * @brief Mesure un moteur sur une prise.
+     */
+    Resultat mesurer(const string &nomMoteur, MethodeCorrelation methode, int pas, bool progressive,
+                     const Prise &prise, double duree, double plage, span<const float> ref, span<const float> cible,
+                     double vrai) {
+        synchro.configurerAnalyse(duree, plage, pas, methode);
+        synchro.configurerRechercheProgressive(progressive);
+
+        Resultat resultat{nomMoteur, prise.nom, duree, plage, 0.0, 0.0, 0.0, numeric_limits<double>::infinity(),
+                          static_cast<double>(ref.size() + cible.size()), {}};
+
+        for (int r = 0; r < repetitions; ++r) {
+            // Les compteurs de travail sont relevés par une étape de Metriques, sur ce thread.
+            Metriques metriques;
+            optional<ResultatDecalage> mesure;
+
+            const auto debut = chrono::steady_clock::now();
+            {
+                Metriques::Etape etape(&metriques, nomMoteur);
+                try {
+                    mesure = synchro.calculerDecalage(ref, cible);
+                } catch (const exception &) {
+                    // Aucun retard trouvé : erreur infinie.
+                }
+            }
+            const double secondes = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+            resultat.erreur = mesure ? abs(mesure->decalage * frequence - vrai) : numeric_limits<double>::infinity();
+            resultat.rapportPicLobes = mesure ? mesure->rapportPicLobes : 0.0;
+            resultat.plageExploree = mesure ? mesure->plageExploree : 0.0;
+            resultat.travail = metriques.obtenirEnregistrements().front().travail;
+            resultat.secondes = min(resultat.secondes, secondes);
+        }
+
+        return resultat;
+    }
+
+public:
+    /**
+     * @brief Génère la scène.
+     * @param repetitions Nombre de répétitions de chaque mesure.
+     */
+    explicit BancEssai(int repetitions)
+        : frequence(synchro.FREQUENCE_ECHANTILLONNAGE), repetitions(max(1, repetitions)) {
+        synchro.configurerParallelisme(1);
+
+        // Marge, plus longue analyse, plus la marge des grands retards négatifs.
+        scene = genererScene(MARGE + 120.0 + MARGE, frequence, 2024);
+    }
+
+    /**
+     * @brief Exécute toutes les mesures.
+     * @param rapide Réduit les durées, plages et pas explorés.
+     * @return Les résultats, dans l'ordre d'exécution.
+     */
+    vector<Resultat> executer(bool rapide) {
+        const vector<Prise> prises = {
+            {"propre", 3.25713, numeric_limits<double>::infinity(), 1.0, 0.0, 1.0},
+            {"negatif", -2.71829, numeric_limits<double>::infinity(), 1.0, 0.0, 1.0},
+            {"bruit 10 dB", 1.41421, 10.0, 1.0, 0.0, 1.0},
+            {"bruit 0 dB", 1.41421, 0.0, 1.0, 0.0, 1.0},
+            {"gain 0.05", -0.57721, numeric_limits<double>::infinity(), 0.05, 0.0, 1.0},
+            {"derive 100 ppm", 2.23607, 30.0, 1.0, 1e-4, 1.0},
+            {"cible courte", 1.73205, 30.0, 1.0, 0.0, 0.5},
+            {"grand retard", 12.3456, 30.0, 1.0, 0.0, 1.0}
+        };
+
+        const vector<double> durees = rapide ? vector<double>{20.0} : vector<double>{20.0, 60.0, 120.0};
+        const vector<double> plages = rapide ? vector<double>{5.0} : vector<double>{5.0, 15.0, 30.0};
+        const vector<int> pasDirects = rapide ? vector<int>{100} : vector<int>{50, 100, 200};
+
+        vector<Resultat> resultats;
+        vector<float> ref, cible;
+
+        for (const Prise &prise: prises) {
+            for (const double duree: durees) {
+                const double vrai = filmer(prise, duree, ref, cible);
+
+                for (const double plage: plages) {
+                    const bool horsPlage = abs(prise.retard) >= plage;
+
+                    const auto ajouter = [&](const string &nom, MethodeCorrelation methode, int pas,
+                                             bool progressive = false) {
+                        resultats.push_back(mesurer(nom, methode, pas, progressive, prise, duree, plage, ref, cible,
+                                                    vrai));
+                        afficher(resultats.back());
+                    };
+
+                    // Les moteurs à plage bornée ne peuvent trouver un retard hors de la plage.
+                    if (!horsPlage) {
+                        for (const int pas: pasDirects) ajouter("directe/" + to_string(pas), MethodeCorrelation::Directe, pas);
+                        ajouter("fft", MethodeCorrelation::FFT, 1);
+                        ajouter("hierarchique", MethodeCorrelation::Hierarchique, 1);
+
+                        // Recherche progressive autour d'un a priori nul : gain attendu quand le retard est faible.
+                        ajouter("fft/progressive", MethodeCorrelation::FFT, 1, true);
+                        ajouter("hier./progressive", MethodeCorrelation::Hierarchique, 1, true);
+                    }
+
+                    // La plage n'influe pas sur le vote d'empreintes : une seule mesure par durée.
+                    if (plage == plages.front()) ajouter("empreinte", MethodeCorrelation::Empreinte, 1);
+                }
+            }
+        }
+
+        return resultats;
+    }
+
+    /**
+     * @brief Affiche une ligne de résultat.
+     */
+    static void afficher(const Resultat &r) {
+        const auto debit = [&r](double quantite) { return r.secondes > 0.0 ? quantite / r.secondes / 1e6 : 0.0; };
+
+        cout << left << setw(18) << r.moteur << setw(16) << r.prise << right
+                << setw(6) << fixed << setprecision(0) << r.duree << "s"
+                << setw(5) << r.plage << "s"
+                << setw(12) << setprecision(2) << r.erreur << " éch."
+                << setw(10) << setprecision(4) << r.secondes << "s"
+                << setw(8) << setprecision(1) << r.rapportPicLobes << " pic/lobes"
+                << setw(6) << r.plageExploree << "s"
+                << setw(10) << setprecision(1) << debit(r.echantillonsEntree) << " Méch/s"
+                << setw(10) << debit(static_cast<double>(r.travail.echantillons)) << " Mcorr/s"
+                << setw(10) << debit(static_cast<double>(r.travail.retards)) << " Mretards/s" << endl;
+    }
+
+    /**
+     * @brief Affiche, par moteur, l'erreur moyenne et maximale et le temps cumulé.
+     */
+    static void resumer(const vector<Resultat> &resultats) {
+        struct Cumul {
+            int mesures = 0, echecs = 0;
+            double erreurTotale = 0.0, erreurMax = 0.0, secondes = 0.0;
+        };
+
+        map<string, Cumul> cumuls;
+
+        for (const Resultat &r: resultats) {
+            Cumul &cumul = cumuls[r.moteur];
+            cumul.secondes += r.secondes;
+
+            // Les échecs sont comptés à part pour ne pas rendre la moyenne infinie.
+            if (isinf(r.erreur)) {
+                ++cumul.echecs;
+                continue;
+            }
+
+            ++cumul.mesures;
+            cumul.erreurTotale += r.erreur;
+            cumul.erreurMax = max(cumul.erreurMax, r.erreur);
+        }
+
+        cout << "\nRésumé par moteur (erreur en échantillons)" << endl;
+
+        for (const auto &[moteur, cumul]: cumuls) {
+            cout << left << setw(18) << moteur << right << setw(4) << cumul.mesures << " mesures"
+                    << setw(3) << cumul.echecs << " échecs"
+                    << "  erreur moyenne " << setw(10) << setprecision(2)
+                    << (cumul.mesures > 0 ? cumul.erreurTotale / cumul.mesures : 0.0)
+                    << "  max " << setw(10) << cumul.erreurMax
+                    << "  temps " << setw(8) << setprecision(3) << cumul.secondes << "s" << endl;
+        }
+    }
+
+    /**
+     * @brief Écrit les résultats au format CSV, pour le suivi d'une version à l'autre.
+     */
+    static void ecrireCSV(const string &fichier, const vector<Resultat> &resultats) {
+        ofstream flux(fichier);
+        if (!flux) throw runtime_error("Impossible d'écrire : " + fichier);
+
+        flux << "moteur,prise,duree,plage,erreur_echantillons,rapport_pic_lobes,plage_exploree,secondes,"
+                << "echantillons_entree,echantillons_correles,retards\n";
+
+        for (const Resultat &r: resultats) {
+            flux << r.moteur << "," << r.prise << "," << r.duree << "," << r.plage << "," << r.erreur << ","
+                    << r.rapportPicLobes << "," << r.plageExploree << "," << r.secondes << ","
+                    << r.echantillonsEntree << "," << r.travail.echantillons << "," << r.travail.retards << "\n";
+        }
+    }
+};
+
+int main(int argc, char *argv[]) {
+    bool rapide = false;
+    int repetitions = 1;
+    string fichierCSV;
+
+    for (int i = 1; i < argc; ++i) {
+        const string argument = argv[i];
+
+        if (argument == "--rapide") {
+            rapide = true;
+        } else if (argument == "--repetitions" && i + 1 < argc) {
+            repetitions = stoi(argv[++i]);
+        } else if (argument == "--csv" && i + 1 < argc) {
+            fichierCSV = argv[++i];
+        } else {
+            cerr << "Usage : " << argv[0] << " [--rapide] [--repetitions N] [--csv fichier.csv]" << endl;
+            return 1;
+        }
+    }
+
+    try {
+        cout << "Génération de la scène synthétique..." << endl;
+        BancEssai banc(repetitions);
+
+        const vector<Resultat> resultats = banc.executer(rapide);
+        BancEssai::resumer(resultats);
+
+        if (!fichierCSV.empty()) BancEssai::ecrireCSV(fichierCSV, resultats);
+    } catch (const exception &e) {
+        cerr << "[Erreur] " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+using namespace std;
+
+struct AVFrame;
+
+/**
+ * @class ArenaImages
+ * @brief Ensemble fixe d'images YUV 4:2:0 alignées, allouées une seule fois et recyclées.
+ *
+ * Toutes les images tiennent dans un unique bloc aligné sur 64 octets, dont chaque ligne de chaque plan
+ * commence elle aussi sur 64 octets. Les images sont peintes en noir à la création ; elles sont ensuite
+ * confiées à l'appelant puis rendues, sans aucune allocation. Une image encore référencée par l'encodeur
+ * n'est pas confiée à nouveau.
+ */
+class ArenaImages {
+    /**
+     * @brief Libère le bloc aligné.
+     */
+    struct LiberationAlignee {
+        void operator()(uint8_t *bloc) const { ::operator delete[](bloc, align_val_t(ALIGNEMENT)); }
+    };
+
+    /**
+     * @brief Bloc mémoire partagé par toutes les images.
+     */
+    unique_ptr<uint8_t[], LiberationAlignee> bloc;
+
+    /**
+     * @brief Images décrivant chacune sa portion du bloc.
+     */
+    vector<AVFrame *> images;
+
+    /**
+     * @brief Indique les images confiées à l'appelant.
+     */
+    vector<bool> confiees;
+
+    /**
+     * @brief Prochaine image examinée par acquerir().
+     */
+    size_t prochaine = 0;
+
+public:
+    /**
+     * @brief Alignement des plans et des lignes (en octets), suffisant pour AVX-512.
+     */
+    static constexpr size_t ALIGNEMENT = 64;
+
+    /**
+     * @brief Alloue et peint en noir toutes les images.
+     * @param largeur Largeur des images (en pixels, paire).
+     * @param hauteur Hauteur des images (en pixels, paire).
+     * @param nombre Nombre d'images.
+     * @throws runtime_error Si l'allocation échoue.
+     */
+    ArenaImages(int largeur, int hauteur, size_t nombre);
+
+    /**
+     * @brief Libère les images et le bloc.
+     */
+    ~ArenaImages();
+
+    ArenaImages(const ArenaImages &) = delete;
+
+    ArenaImages &operator=(const ArenaImages &) = delete;
+
+    /**
+     * @brief Confie une image libre, qui n'est plus référencée par personne.
+     * @return L'image, dont le contenu précédent est conservé.
+     * @throws runtime_error Si toutes les images sont confiées ou encore référencées.
+     */
+    AVFrame *acquerir();
+
+    /**
+     * @brief Rend une image précédemment confiée.
+     */
+    void rendre(AVFrame *image);
+};
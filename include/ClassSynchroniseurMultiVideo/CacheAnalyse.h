@@ -0,0 +1,62 @@
+#pragma once
+
+#include "SignalAudio.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+
+using namespace std;
+
+/**
+ * @class CacheAnalyse
+ * @brief Cache disque des signaux d'analyse décodés, projetés en mémoire lors de leur réutilisation.
+ *
+ * Chaque entrée est identifiée par le chemin canonique du fichier source, sa taille, sa date de modification,
+ * une empreinte de son contenu et les paramètres d'analyse (fréquence, durée). Une entrée valide est
+ * relue par projection mémoire : aucun décodage ni copie n'est nécessaire.
+ */
+class CacheAnalyse {
+    /**
+     * @brief Dossier contenant les entrées du cache.
+     */
+    filesystem::path dossier;
+
+    /**
+     * @brief Calcule une empreinte rapide du contenu (début, milieu et fin du fichier).
+     */
+    static uint64_t empreinteContenu(const filesystem::path &fichier, uintmax_t taille);
+
+public:
+    /**
+     * @brief Ouvre (et crée si besoin) le dossier du cache.
+     * @param dossier Dossier du cache.
+     * @throws filesystem::filesystem_error Si le dossier ne peut pas être créé.
+     */
+    explicit CacheAnalyse(const filesystem::path &dossier);
+
+    /**
+     * @brief Calcule la clé d'un fichier source pour des paramètres d'analyse donnés.
+     *
+     * @param fichier Chemin du fichier source.
+     * @param frequence Fréquence d'échantillonnage du signal d'analyse (en Hz).
+     * @param duree Durée analysée (en secondes).
+     * @return La clé (hexadécimale), ou une chaîne vide si le fichier n'est pas un fichier régulier.
+     */
+    static string calculerCle(const string &fichier, int frequence, double duree);
+
+    /**
+     * @brief Projette en mémoire l'entrée associée à une clé.
+     * @return Le signal, ou rien si l'entrée est absente ou invalide.
+     */
+    optional<SignalAudio> charger(const string &cle, int frequence) const;
+
+    /**
+     * @brief Enregistre un signal (écriture dans un fichier temporaire puis renommage atomique).
+     *
+     * Une erreur d'écriture n'est pas fatale : l'entrée est simplement absente du cache.
+     */
+    void enregistrer(const string &cle, int frequence, span<const float> echantillons) const;
+};
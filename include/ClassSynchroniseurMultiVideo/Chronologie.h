@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Chronologie
+ * @brief Place des sources décalées sur une chronologie de sortie commune.
+ *
+ * Une source de retard r couvre, en temps de référence, l'intervalle [-r, durée - r] : son instant 0
+ * correspond à l'instant -r de la référence. La chronologie ramène toutes les sources à un zéro commun :
+ * soit le début de leur recouvrement (toutes les sources sont coupées au début et à la fin de la partie
+ * commune), soit le début de la première source (les sources tardives sont retardées, puis complétées
+ * jusqu'à la fin de la dernière).
+ */
+class Chronologie {
+public:
+    /**
+     * @struct Placement
+     * @brief Lecture d'une source sur la chronologie de sortie.
+     */
+    struct Placement {
+        double debutLecture; /**< Position de lecture dans la source à l'instant 0 (en secondes, positive). */
+        double delai; /**< Temps d'attente avant la première image de la source (en secondes). */
+        double duree; /**< Durée lue dans la source (en secondes, infinie si inconnue). */
+    };
+
+private:
+    /**
+     * @struct Source
+     * @brief Retard et durée d'une source.
+     */
+    struct Source {
+        double retard;
+        double duree;
+    };
+
+    /**
+     * @brief Sources, dans l'ordre d'ajout.
+     */
+    vector<Source> sources;
+
+    /**
+     * @brief true pour ne garder que la partie commune à toutes les sources.
+     */
+    bool recouvrementSeul;
+
+    /**
+     * @brief Calcule les bornes de la sortie en temps de référence.
+     * @param debut Instant de référence correspondant à l'instant 0 de la sortie.
+     * @param fin Instant de référence de fin de la sortie (infini si aucune durée n'est connue).
+     */
+    void calculerBornes(double &debut, double &fin) const;
+
+public:
+    /**
+     * @brief Crée une chronologie vide.
+     * @param recouvrementSeul true pour couper au recouvrement commun, false pour couvrir toutes les sources.
+     */
+    explicit Chronologie(bool recouvrementSeul);
+
+    /**
+     * @brief Ajoute une source.
+     * @param retard Retard de la source par rapport à la référence (en secondes).
+     * @param duree Durée de la source (en secondes, négative si inconnue).
+     */
+    void ajouterSource(double retard, double duree);
+
+    /**
+     * @brief Calcule la lecture de chaque source, dans l'ordre d'ajout.
+     * @throws runtime_error Si les sources n'ont aucune partie commune (mode recouvrement).
+     */
+    vector<Placement> placer() const;
+
+    /**
+     * @brief Durée totale de la sortie (en secondes, infinie si aucune durée n'est connue).
+     */
+    double obtenirDuree() const;
+};
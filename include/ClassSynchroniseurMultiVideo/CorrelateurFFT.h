@@ -0,0 +1,46 @@
+#pragma once
+
+#include "TransformeeFourier.h"
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class CorrelateurFFT
+ * @brief Calcule la corrélation croisée de deux signaux pour tous les retards en O(n log n).
+ *
+ * Les deux signaux réels sont empaquetés dans un seul signal complexe afin de n'effectuer
+ * qu'une FFT directe et une FFT inverse par appel. Le plan et les tampons sont conservés
+ * entre deux appels de même taille pour éviter les réallocations.
+ */
+class CorrelateurFFT {
+    /**
+     * @brief Plan FFT courant (recréé uniquement si la taille nécessaire change).
+     */
+    unique_ptr<TransformeeFourier> plan;
+
+    /**
+     * @brief Tampon de travail complexe de la taille du plan.
+     */
+    vector<complex<double> > tampon;
+
+public:
+    /**
+     * @brief Calcule c[k] = somme_i ref[i] * cible[i + k] pour k dans [retardMin, retardMax].
+     *
+     * Les termes pour lesquels i + k sort de la cible sont ignorés, comme dans la corrélation directe.
+     *
+     * @param ref Signal de référence.
+     * @param cible Signal cible.
+     * @param retardMin Premier retard évalué (en échantillons, peut être négatif).
+     * @param retardMax Dernier retard évalué (inclus).
+     * @param sortie Reçoit retardMax - retardMin + 1 valeurs de corrélation.
+     */
+    void correler(span<const float> ref, span<const float> cible, ptrdiff_t retardMin, ptrdiff_t retardMax,
+                  vector<double> &sortie);
+};
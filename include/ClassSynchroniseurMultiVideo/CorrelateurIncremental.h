@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CorrelateurFFT.h"
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class CorrelateurIncremental
+ * @brief Accumule une corrélation croisée bloc par bloc, sans jamais disposer du signal complet.
+ *
+ * Pour chaque bloc de référence ref[a, a + n[, l'appelant fournit la portion de cible
+ * cible[a + retardMin, a + n + retardMax[ ; la contribution du bloc à chaque retard est
+ * calculée par FFT et ajoutée à la corrélation accumulée. Le plan FFT et les tampons
+ * sont réutilisés d'un bloc à l'autre.
+ *
+ * Lorsque les deux signaux arrivent en continu, les blocs de cible peuvent aussi être accumulés
+ * contre la référence déjà reçue (accumulerCible) : chaque paire d'échantillons n'est alors
+ * corrélée qu'une fois, dès que ses deux échantillons sont disponibles.
+ */
+class CorrelateurIncremental {
+    /**
+     * @brief Premier retard suivi (en échantillons).
+     */
+    ptrdiff_t retardMin;
+
+    /**
+     * @brief Dernier retard suivi (inclus).
+     */
+    ptrdiff_t retardMax;
+
+    /**
+     * @brief Moteur FFT réutilisé pour chaque bloc.
+     */
+    CorrelateurFFT correlateur;
+
+    /**
+     * @brief Corrélation accumulée pour chaque retard.
+     */
+    vector<double> correlation;
+
+    /**
+     * @brief Contribution du dernier bloc.
+     */
+    vector<double> contribution;
+
+public:
+    /**
+     * @brief Prépare l'accumulation pour les retards [retardMin, retardMax].
+     */
+    CorrelateurIncremental(ptrdiff_t retardMin, ptrdiff_t retardMax);
+
+    /**
+     * @brief Ajoute la contribution d'un bloc de référence.
+     *
+     * @param blocRef Bloc de référence ref[a, a + n[.
+     * @param segmentCible Cible sur [a + retardMin, a + n + retardMax[ (zéros hors du signal).
+     * @throws invalid_argument Si le segment de cible n'a pas la taille attendue.
+     */
+    void accumuler(span<const float> blocRef, span<const float> segmentCible);
+
+    /**
+     * @brief Ajoute la contribution d'un bloc de cible.
+     *
+     * @param blocCible Bloc de cible cible[b, b + m[.
+     * @param segmentRef Référence sur [b - retardMax, b + m - retardMin[ (zéros hors du signal).
+     * @throws invalid_argument Si le segment de référence n'a pas la taille attendue.
+     */
+    void accumulerCible(span<const float> blocCible, span<const float> segmentRef);
+
+    /**
+     * @brief Multiplie la corrélation accumulée par un facteur, pour oublier progressivement les anciens blocs.
+     */
+    void attenuer(double facteur);
+
+    /**
+     * @brief Remet la corrélation accumulée à zéro.
+     */
+    void reinitialiser();
+
+    /**
+     * @brief Corrélation accumulée ; l'indice i correspond au retard retardMin + i.
+     */
+    const vector<double> &obtenirCorrelation() const;
+
+    /**
+     * @brief Estime la mémoire de travail (en octets) nécessaire pour des blocs de taille donnée.
+     */
+    static size_t estimerMemoire(size_t tailleBloc, ptrdiff_t retardMin, ptrdiff_t retardMax);
+};
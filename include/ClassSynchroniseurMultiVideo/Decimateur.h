@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Decimateur
+ * @brief Filtre passe-bas suivi d'un sous-échantillonnage d'un facteur entier.
+ *
+ * Le filtre est un sinus cardinal fenêtré (Blackman) dont la coupure se situe juste sous
+ * la nouvelle fréquence de Nyquist, afin d'éviter le repliement spectral. Seuls les échantillons
+ * conservés sont calculés.
+ */
+class Decimateur {
+    /**
+     * @brief Facteur de sous-échantillonnage.
+     */
+    size_t facteur;
+
+    /**
+     * @brief Coefficients du filtre passe-bas (longueur impaire, centrés).
+     */
+    vector<float> coefficients;
+
+public:
+    /**
+     * @brief Construit le filtre pour un facteur donné.
+     * @param facteur Facteur de sous-échantillonnage (1 pour une simple copie).
+     */
+    explicit Decimateur(size_t facteur);
+
+    /**
+     * @brief Retourne le facteur de sous-échantillonnage.
+     */
+    size_t obtenirFacteur() const;
+
+    /**
+     * @brief Filtre et sous-échantillonne un signal.
+     *
+     * L'échantillon de sortie m correspond à l'échantillon d'entrée m * facteur.
+     *
+     * @param entree Signal à la fréquence d'origine.
+     * @param sortie Reçoit ceil(entree.size() / facteur) échantillons.
+     */
+    void decimer(span<const float> entree, vector<float> &sortie) const;
+};
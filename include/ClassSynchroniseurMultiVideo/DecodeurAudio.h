@@ -0,0 +1,180 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+struct SwrContext;
+
+/**
+ * @class DecodeurAudio
+ * @brief Décode la piste audio d'un fichier en mémoire, sans processus externe ni fichier temporaire.
+ *
+ * Seul le flux audio est démultiplexé (les autres flux sont ignorés par le démultiplexeur),
+ * puis décodé et rééchantillonné en mono, float 32 bits, à la fréquence demandée.
+ * Les échantillons sont écrits directement dans le tampon fourni par l'appelant.
+ *
+ * En mode direct, la source peut être un fichier en cours d'écriture, un tube nommé ou une URL
+ * de flux (tcp://, udp://...) : la lecture attend les nouvelles données au lieu de s'arrêter
+ * à la fin du fichier, et le flux ne se termine qu'à sa fermeture ou après une inactivité prolongée.
+ */
+class DecodeurAudio {
+    /**
+     * @brief Contexte de démultiplexage du fichier source.
+     */
+    AVFormatContext *format = nullptr;
+
+    /**
+     * @brief Contexte du décodeur audio.
+     */
+    AVCodecContext *decodeur = nullptr;
+
+    /**
+     * @brief Convertisseur vers mono float 32 bits à la fréquence cible.
+     */
+    SwrContext *reechantillonneur = nullptr;
+
+    /**
+     * @brief Paquet compressé en cours de lecture.
+     */
+    AVPacket *paquet = nullptr;
+
+    /**
+     * @brief Trame décodée en cours de conversion.
+     */
+    AVFrame *trame = nullptr;
+
+    /**
+     * @brief Index du flux audio sélectionné dans le conteneur.
+     */
+    int indexFlux = -1;
+
+    /**
+     * @brief Fréquence d'échantillonnage de sortie (en Hz).
+     */
+    int frequence;
+
+    /**
+     * @brief Échantillons convertis qui n'ont pas encore tenu dans le tampon de l'appelant.
+     */
+    vector<float> reliquat;
+
+    /**
+     * @brief Position de lecture dans le reliquat.
+     */
+    size_t positionReliquat = 0;
+
+    /**
+     * @brief Indique que le décodeur et le rééchantillonneur ont été entièrement vidés.
+     */
+    bool termine = false;
+
+    /**
+     * @brief Position demandée par le dernier appel à chercher() (en secondes).
+     */
+    double positionDemandee = 0.0;
+
+    /**
+     * @brief Indique que la première trame suivant un déplacement n'a pas encore été reçue.
+     */
+    bool alignementEnAttente = false;
+
+    /**
+     * @brief Échantillons à écarter pour tomber exactement sur la position demandée.
+     */
+    size_t echantillonsASauter = 0;
+
+    /**
+     * @brief Lecture en direct : une coupure du flux le termine au lieu de lever une erreur.
+     */
+    bool direct;
+
+    /**
+     * @brief Inactivité au-delà de laquelle un fichier suivi en direct est considéré terminé (en secondes).
+     */
+    static constexpr double DELAI_INACTIVITE = 10.0;
+
+    /**
+     * @brief Convertit la trame courante directement dans la destination, le surplus allant au reliquat.
+     * @param destination Zone libre du tampon de l'appelant.
+     * @param entree Plans de la trame décodée (nullptr pour vider le rééchantillonneur).
+     * @param nbEntree Nombre d'échantillons de la trame.
+     * @return Nombre d'échantillons écrits dans la destination.
+     */
+    size_t convertir(span<float> destination, const uint8_t *const *entree, int nbEntree);
+
+    /**
+     * @brief Libère toutes les ressources FFmpeg.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Ouvre un fichier et prépare le décodage de sa meilleure piste audio.
+     *
+     * @param fichier Chemin du fichier audio ou vidéo (ou URL de flux en mode direct).
+     * @param frequence Fréquence d'échantillonnage de sortie (en Hz).
+     * @param direct Suit la source en cours d'écriture, avec une analyse initiale courte.
+     * @param arret Indicateur consulté pendant les attentes de FFmpeg : s'il passe à true, l'ouverture
+     *              échoue et la lecture se termine (nullptr pour aucun).
+     * @throws runtime_error Si le fichier ne peut pas être ouvert ou ne contient pas d'audio.
+     */
+    DecodeurAudio(const string &fichier, int frequence, bool direct = false, const atomic<bool> *arret = nullptr);
+
+    /**
+     * @brief Libère le décodeur.
+     */
+    ~DecodeurAudio();
+
+    DecodeurAudio(const DecodeurAudio &) = delete;
+
+    DecodeurAudio &operator=(const DecodeurAudio &) = delete;
+
+    /**
+     * @brief Décode les échantillons suivants dans le tampon de l'appelant.
+     *
+     * @param destination Tampon à remplir.
+     * @return Nombre d'échantillons écrits. Une valeur inférieure à la taille du tampon indique la fin du flux.
+     * @throws runtime_error En cas d'erreur de décodage.
+     */
+    size_t lire(span<float> destination);
+
+    /**
+     * @brief Se déplace à une position donnée du flux audio.
+     *
+     * Le démultiplexeur se positionne sur le paquet précédant la position, puis les échantillons
+     * décodés en trop sont écartés : la lecture reprend à l'échantillon près.
+     *
+     * @param secondes Position depuis le début du flux audio (en secondes).
+     * @throws runtime_error Si le conteneur ne permet pas le déplacement.
+     */
+    void chercher(double secondes);
+
+    /**
+     * @brief Décode au plus dureeMax secondes depuis la position courante dans un vecteur.
+     *
+     * La capacité du vecteur est réutilisée d'un appel à l'autre.
+     *
+     * @param sortie Vecteur recevant les échantillons (redimensionné au nombre décodé).
+     * @param dureeMax Durée maximale à décoder (en secondes).
+     */
+    void lireTout(vector<float> &sortie, double dureeMax);
+
+    /**
+     * @brief Lit la durée d'un fichier dans son conteneur, sans rien décoder.
+     *
+     * @param fichier Chemin du fichier audio ou vidéo.
+     * @return La durée en secondes, ou -1 si le conteneur ne l'indique pas.
+     * @throws runtime_error Si le fichier ne peut pas être ouvert.
+     */
+    static double mesurerDuree(const string &fichier);
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+
+/**
+ * @class DecodeurVideo
+ * @brief Décode la piste vidéo d'un fichier et fournit l'image affichée à un instant donné.
+ *
+ * Seul le flux vidéo est démultiplexé. Une image d'avance est décodée afin de savoir à quel instant
+ * l'image courante cesse d'être affichée : les images sont répétées ou sautées pour suivre la cadence
+ * demandée par l'appelant, comme le ferait un filtre fps.
+ *
+ * Quand l'appelant indique la taille et la cadence dont il a besoin, le décodeur travaille à résolution
+ * réduite si le codec le permet, et écarte les images non référencées lorsque les images restantes suffisent
+ * encore à la cadence demandée (sources sans images B au moins deux fois plus rapides, ou sur demande).
+ */
+class DecodeurVideo {
+public:
+    /**
+     * @struct Reduction
+     * @brief Réglages de décodage réduit d'une source, choisis d'après la taille et la cadence utiles.
+     */
+    struct Reduction {
+        int resolution = 0; /**< Décodage à 1/2^resolution de la taille native (lowres), si le codec le permet. */
+        bool nonReferencees = false; /**< Images non référencées écartées avant décodage (skip_frame). */
+        int largeur = 0; /**< Largeur des images décodées (en pixels). */
+        int hauteur = 0; /**< Hauteur des images décodées (en pixels). */
+    };
+
+private:
+    /**
+     * @brief Contexte de démultiplexage du fichier source.
+     */
+    AVFormatContext *format = nullptr;
+
+    /**
+     * @brief Contexte du décodeur vidéo.
+     */
+    AVCodecContext *decodeur = nullptr;
+
+    /**
+     * @brief Paquet compressé en cours de lecture.
+     */
+    AVPacket *paquet = nullptr;
+
+    /**
+     * @brief Image affichée à l'instant courant.
+     */
+    AVFrame *courante = nullptr;
+
+    /**
+     * @brief Image suivante, déjà décodée.
+     */
+    AVFrame *suivante = nullptr;
+
+    /**
+     * @brief Index du flux vidéo sélectionné dans le conteneur.
+     */
+    int indexFlux = -1;
+
+    /**
+     * @brief Indique qu'une image courante est disponible.
+     */
+    bool courantePrete = false;
+
+    /**
+     * @brief Indique qu'une image suivante est disponible.
+     */
+    bool suivantePrete = false;
+
+    /**
+     * @brief Indique que le décodeur a été entièrement vidé.
+     */
+    bool termine = false;
+
+    /**
+     * @brief Réglages de décodage réduit appliqués à l'ouverture.
+     */
+    Reduction reduction;
+
+    /**
+     * @brief Décode l'image suivante.
+     * @return false à la fin du flux.
+     */
+    bool decoderSuivante();
+
+    /**
+     * @brief Instant de présentation d'une image (en secondes depuis le début du flux).
+     */
+    double instant(const AVFrame *image) const;
+
+    /**
+     * @brief Libère toutes les ressources FFmpeg.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Ouvre un fichier et prépare le décodage de sa meilleure piste vidéo.
+     *
+     * @param fichier Chemin du fichier vidéo.
+     * @param threads Nombre de threads du décodeur (0 pour le choix automatique de FFmpeg).
+     * @param largeurUtile Largeur à laquelle les images seront affichées (0 pour décoder en pleine résolution).
+     * @param hauteurUtile Hauteur à laquelle les images seront affichées.
+     * @param cadenceUtile Cadence à laquelle les images seront lues (0 pour décoder toutes les images).
+     * @param ecarterImagesB true pour écarter aussi les images non référencées d'une source à images B,
+     *                       si elle reste assez rapide en n'en gardant qu'une sur video_delay + 2.
+     * @throws runtime_error Si le fichier ne peut pas être ouvert ou ne contient pas de vidéo.
+     */
+    DecodeurVideo(const string &fichier, int threads, int largeurUtile = 0, int hauteurUtile = 0,
+                  double cadenceUtile = 0.0, bool ecarterImagesB = false);
+
+    /**
+     * @brief Libère le décodeur.
+     */
+    ~DecodeurVideo();
+
+    DecodeurVideo(const DecodeurVideo &) = delete;
+
+    DecodeurVideo &operator=(const DecodeurVideo &) = delete;
+
+    /**
+     * @brief Se déplace à une position donnée du flux vidéo.
+     *
+     * Le démultiplexeur se positionne sur l'image clé précédente ; les images intermédiaires
+     * sont décodées puis écartées par obtenirImage().
+     *
+     * @param secondes Position depuis le début du flux (en secondes).
+     * @throws runtime_error Si le conteneur ne permet pas le déplacement.
+     */
+    void chercher(double secondes);
+
+    /**
+     * @brief Retourne l'image affichée à un instant donné.
+     *
+     * Les instants doivent être croissants d'un appel à l'autre. L'image reste valide jusqu'à l'appel suivant.
+     *
+     * @param secondes Instant depuis le début du flux (en secondes).
+     * @return L'image, ou nullptr si le flux ne contient aucune image.
+     * @throws runtime_error En cas d'erreur de décodage.
+     */
+    const AVFrame *obtenirImage(double secondes);
+
+    /**
+     * @brief Retourne les réglages de décodage réduit appliqués.
+     */
+    const Reduction &obtenirReduction() const;
+
+    /**
+     * @brief Choisit les réglages de décodage réduit d'un fichier, sans ouvrir de décodeur.
+     *
+     * Sert aux décodeurs externes (ligne de commande ffmpeg) : les réglages sont ceux qu'appliquerait le constructeur.
+     *
+     * @param fichier Chemin du fichier vidéo.
+     * @param largeurUtile Largeur à laquelle les images seront affichées.
+     * @param hauteurUtile Hauteur à laquelle les images seront affichées.
+     * @param cadenceUtile Cadence à laquelle les images seront lues.
+     * @param ecarterImagesB Voir le constructeur.
+     * @return Les réglages choisis.
+     * @throws runtime_error Si le fichier ne peut pas être ouvert ou ne contient pas de vidéo.
+     */
+    static Reduction sonder(const string &fichier, int largeurUtile, int hauteurUtile, double cadenceUtile,
+                            bool ecarterImagesB = false);
+};
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Metriques;
+
+/**
+ * @class EstimateurDerive
+ * @brief Suit le décalage d'une vidéo au cours du temps et en déduit la dérive de son horloge.
+ *
+ * De courtes fenêtres de la référence, réparties sur toute sa longueur, sont corrélées avec la cible
+ * autour du décalage déjà connu. Un modèle retard(t) = retard + derive * t est ensuite ajusté par
+ * moindres carrés pondérés par la corrélation normalisée de chaque fenêtre, les fenêtres incohérentes
+ * (silence, passage sans rapport) étant écartées. Seules les fenêtres sont décodées, par déplacement
+ * dans les fichiers : la mémoire est bornée par la taille d'une fenêtre par thread, quelle que soit
+ * la durée des enregistrements. Les fenêtres sont réparties en tranches contiguës, une par thread,
+ * chacune avec ses décodeurs, son plan FFT et ses tampons réutilisés d'une fenêtre à l'autre.
+ */
+class EstimateurDerive {
+public:
+    /**
+     * @struct Mesure
+     * @brief Décalage mesuré sur une fenêtre.
+     */
+    struct Mesure {
+        double instant; /**< Centre de la fenêtre dans la référence (en secondes). */
+        double retard; /**< Décalage de la cible à cet instant (en secondes). */
+        double score; /**< Corrélation normalisée au pic (0 à 1). */
+    };
+
+    /**
+     * @struct Modele
+     * @brief Décalage affine ajusté sur les fenêtres retenues.
+     */
+    struct Modele {
+        double retard; /**< Décalage à l'instant 0 de la référence (en secondes). */
+        double derive; /**< Dérive de l'horloge de la cible (secondes gagnées par seconde de référence). */
+        double residu; /**< Écart quadratique moyen des fenêtres retenues au modèle (en secondes). */
+        int fenetres; /**< Nombre de fenêtres retenues. */
+    };
+
+private:
+    /**
+     * @brief Fréquence d'échantillonnage de l'analyse (en Hz).
+     */
+    int frequence;
+
+    /**
+     * @brief Durée d'une fenêtre (en secondes).
+     */
+    double dureeFenetre;
+
+    /**
+     * @brief Écart entre les débuts de deux fenêtres consécutives (en secondes).
+     */
+    double intervalle;
+
+    /**
+     * @brief Écart maximal cherché autour du décalage initial (en secondes).
+     */
+    double plage;
+
+    /**
+     * @brief Métriques recevant les étapes (nullptr si désactivées).
+     */
+    Metriques *metriques = nullptr;
+
+    /**
+     * @brief Corrélation normalisée minimale d'une fenêtre exploitable.
+     */
+    static constexpr double SCORE_MINIMUM = 0.2;
+
+    /**
+     * @brief Écart au modèle au-delà duquel une fenêtre est écartée (en secondes).
+     */
+    static constexpr double TOLERANCE = 0.02;
+
+    /**
+     * @brief Mesure les fenêtres d'indices [premiere, derniere) avec un décodeur par fichier.
+     *
+     * @param fichierRef Chemin du fichier de référence.
+     * @param fichierCible Chemin du fichier à suivre.
+     * @param retardInitial Décalage autour duquel chaque fenêtre est cherchée (en secondes).
+     * @param premiere Indice de la première fenêtre.
+     * @param derniere Indice suivant la dernière fenêtre.
+     * @return Les mesures des fenêtres exploitables.
+     */
+    vector<Mesure> mesurer(const string &fichierRef, const string &fichierCible, double retardInitial,
+                           size_t premiere, size_t derniere) const;
+
+    /**
+     * @brief Ajuste le modèle affine par moindres carrés pondérés, en écartant les fenêtres incohérentes.
+     *
+     * @param mesures Mesures des fenêtres exploitables.
+     * @return Le modèle ajusté.
+     * @throws runtime_error Si moins de deux fenêtres restent cohérentes.
+     */
+    static Modele ajuster(vector<Mesure> mesures);
+
+public:
+    /**
+     * @brief Prépare l'estimation.
+     *
+     * @param frequence Fréquence d'échantillonnage de l'analyse (en Hz).
+     * @param dureeFenetre Durée d'une fenêtre (en secondes).
+     * @param intervalle Écart entre les débuts de deux fenêtres (en secondes).
+     * @param plage Écart maximal cherché autour du décalage initial (en secondes).
+     */
+    EstimateurDerive(int frequence, double dureeFenetre, double intervalle, double plage);
+
+    /**
+     * @brief Estime le décalage et la dérive d'une cible sur toute la durée commune avec la référence.
+     *
+     * @param fichierRef Chemin du fichier de référence.
+     * @param fichierCible Chemin du fichier à suivre.
+     * @param retardInitial Décalage constant déjà mesuré (en secondes).
+     * @param threads Nombre de threads (0 pour le nombre de cœurs disponibles).
+     * @return Le modèle ajusté.
+     * @throws runtime_error Si les durées sont inconnues ou si trop peu de fenêtres sont exploitables.
+     */
+    Modele estimer(const string &fichierRef, const string &fichierCible, double retardInitial,
+                   size_t threads) const;
+
+    /**
+     * @brief Mesure les étapes dans des métriques partagées.
+     * @param metriques Métriques recevant les étapes (nullptr pour désactiver).
+     */
+    void configurerMetriques(Metriques *metriques);
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Chronologie.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class FicheSynchro
+ * @brief Écrit les décalages et placements calculés dans un fichier annexe.
+ *
+ * La fiche permet à un outil en aval (montage, script ffmpeg en recopie de flux) de reproduire
+ * la synchronisation sans réencoder. Deux formats sont disponibles, choisis par l'extension :
+ * JSON (par défaut) ou EDL CMX 3600 (extension .edl).
+ */
+class FicheSynchro {
+public:
+    /**
+     * @struct Element
+     * @brief Source synchronisée.
+     */
+    struct Element {
+        string chemin; /**< Chemin du fichier. */
+        bool video; /**< true pour une vidéo, false pour l'audio de référence externe. */
+        double retard; /**< Retard mesuré par rapport à la référence (en secondes). */
+        double confiance; /**< Confiance de l'alignement (0 à 1). */
+        double derive; /**< Dérive d'horloge de la source (secondes gagnées par seconde de référence). */
+        Chronologie::Placement placement; /**< Lecture de la source sur la chronologie de sortie. */
+    };
+
+private:
+    /**
+     * @brief Écrit la fiche au format JSON.
+     */
+    static void ecrireJSON(ostream &flux, const vector<Element> &elements, double duree, int imagesParSeconde);
+
+    /**
+     * @brief Écrit la fiche au format EDL CMX 3600 (un événement par source).
+     */
+    static void ecrireEDL(ostream &flux, const vector<Element> &elements, int imagesParSeconde);
+
+public:
+    /**
+     * @brief Écrit la fiche de synchronisation.
+     *
+     * @param fichier Chemin de la fiche (.json ou .edl).
+     * @param elements Sources, dans l'ordre des entrées.
+     * @param duree Durée de la sortie (en secondes, infinie si inconnue).
+     * @param imagesParSeconde Cadence utilisée pour les codes temporels.
+     * @throws runtime_error Si le fichier ne peut pas être écrit.
+     */
+    static void ecrire(const string &fichier, const vector<Element> &elements, double duree, int imagesParSeconde);
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class GrapheAlignement
+ * @brief Résout une chronologie globale à partir de décalages mesurés entre paires de fichiers.
+ *
+ * Chaque mesure (i, j, d, c) affirme que le contenu de j est en retard de d secondes sur celui de i,
+ * avec une confiance c. Les positions sont obtenues par moindres carrés pondérés (poids c²) sur toutes
+ * les mesures fiables de la composante connexe du nœud 0, dont la position est fixée à zéro.
+ * Un arbre couvrant de confiance maximale garantit la connexité ; les mesures hors de l'arbre qui
+ * contredisent la solution sont écartées avant une seconde résolution.
+ */
+class GrapheAlignement {
+public:
+    /**
+     * @struct Position
+     * @brief Position résolue d'un nœud.
+     */
+    struct Position {
+        bool connecte; /**< Le nœud est relié au nœud 0 par des mesures fiables. */
+        double retard; /**< Retard par rapport au nœud 0 (en secondes). */
+        double confiance; /**< Meilleure confiance parmi les mesures retenues qui touchent ce nœud. */
+        double residu; /**< Écart quadratique moyen des mesures retenues qui touchent ce nœud (en secondes). */
+    };
+
+private:
+    /**
+     * @struct Mesure
+     * @brief Décalage mesuré entre deux nœuds.
+     */
+    struct Mesure {
+        size_t i;
+        size_t j;
+        double retard;
+        double confiance;
+    };
+
+    /**
+     * @brief Nombre de nœuds du graphe.
+     */
+    size_t nbNoeuds;
+
+    /**
+     * @brief Mesures ajoutées.
+     */
+    vector<Mesure> mesures;
+
+    /**
+     * @brief Résout le système des moindres carrés pondérés sur les mesures actives.
+     * @param actives Indicateur d'utilisation de chaque mesure.
+     * @param connectes Nœuds reliés au nœud 0.
+     * @return Le retard de chaque nœud (0 pour les nœuds non connectés).
+     */
+    vector<double> resoudreMoindresCarres(const vector<bool> &actives, const vector<bool> &connectes) const;
+
+public:
+    /**
+     * @brief Crée un graphe sans mesure.
+     * @param nbNoeuds Nombre de fichiers à placer.
+     */
+    explicit GrapheAlignement(size_t nbNoeuds);
+
+    /**
+     * @brief Ajoute la mesure « j est en retard de retard secondes sur i ».
+     * @param i Premier nœud.
+     * @param j Second nœud.
+     * @param retard Décalage mesuré (en secondes).
+     * @param confiance Confiance de la mesure (0 à 1).
+     */
+    void ajouterMesure(size_t i, size_t j, double retard, double confiance);
+
+    /**
+     * @brief Calcule la chronologie globale.
+     * @param confianceMin Confiance en dessous de laquelle une mesure est ignorée.
+     * @param toleranceSecondes Écart au-delà duquel une mesure hors arbre couvrant est jugée incohérente.
+     * @return La position de chaque nœud.
+     */
+    vector<Position> resoudre(double confianceMin, double toleranceSecondes) const;
+};
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class IndexEmpreintes
+ * @brief Index d'empreintes audio par repères spectraux, pour l'alignement par vote.
+ *
+ * Le signal est décimé vers environ 11 kHz, puis son spectrogramme est réduit à ses pics les plus saillants.
+ * Chaque pic est associé à quelques pics voisins plus tardifs ; chaque paire (fréquences et écart temporel)
+ * donne un hachage insensible au gain et largement insensible au micro. L'alignement d'un autre signal consiste
+ * à retrouver ses hachages dans l'index et à voter pour l'écart temporel le plus fréquent : le coût ne dépend
+ * que des longueurs des signaux, pas de la plage de décalage recherchée.
+ */
+class IndexEmpreintes {
+public:
+    /**
+     * @struct Repere
+     * @brief Paire de pics spectraux hachée, datée par la trame de son pic d'ancrage.
+     */
+    struct Repere {
+        uint32_t hachage; /**< Fréquence d'ancrage, fréquence cible et écart en trames. */
+        int32_t trame; /**< Trame du pic d'ancrage. */
+    };
+
+    /**
+     * @struct ResultatVote
+     * @brief Résultat de l'alignement d'un signal sur l'index.
+     */
+    struct ResultatVote {
+        double retard; /**< Retard en échantillons à la fréquence d'origine (cible[i + retard] = ref[i]). */
+        int votes; /**< Nombre de repères concordants pour ce retard. */
+        int reperes; /**< Nombre de repères extraits du signal aligné. */
+    };
+
+private:
+    /**
+     * @brief Facteur de décimation vers la fréquence d'analyse spectrale.
+     */
+    int facteur;
+
+    /**
+     * @brief Repères de la référence, triés par hachage.
+     */
+    vector<Repere> reperes;
+
+    /**
+     * @brief Nombre de trames du spectrogramme de la référence.
+     */
+    int nbTrames = 0;
+
+    /**
+     * @brief Extrait les repères d'un signal.
+     * @param signal Signal à la fréquence d'origine.
+     * @param sortie Repères extraits (non triés).
+     * @return Le nombre de trames analysées.
+     */
+    int extraire(span<const float> signal, vector<Repere> &sortie) const;
+
+public:
+    /**
+     * @brief Construit l'index d'un signal de référence.
+     * @param ref Signal de référence.
+     * @param frequence Fréquence d'échantillonnage du signal (en Hz).
+     */
+    IndexEmpreintes(span<const float> ref, int frequence);
+
+    /**
+     * @brief Aligne un signal sur la référence par vote des repères concordants.
+     * @param cible Signal à aligner (même fréquence que la référence).
+     * @return Le retard le plus voté et son score.
+     */
+    ResultatVote aligner(span<const float> cible) const;
+
+    /**
+     * @brief Durée d'une trame du spectrogramme (en échantillons à la fréquence d'origine).
+     */
+    int obtenirPasTrame() const;
+};
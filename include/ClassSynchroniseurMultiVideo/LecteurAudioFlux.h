@@ -0,0 +1,83 @@
+#pragma once
+
+#include "DecodeurAudio.h"
+#include "TamponCirculaire.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+/**
+ * @class LecteurAudioFlux
+ * @brief Lecture audio en flux, par morceaux de taille fixe, dans un tampon circulaire borné.
+ *
+ * Le décodeur écrit directement dans la zone libre du tampon circulaire. La mémoire occupée
+ * est fixée par la capacité du tampon, quelle que soit la durée de l'enregistrement.
+ */
+class LecteurAudioFlux {
+    /**
+     * @brief Décodeur de la piste audio.
+     */
+    DecodeurAudio decodeur;
+
+    /**
+     * @brief Échantillons décodés et pas encore libérés.
+     */
+    TamponCirculaire tampon;
+
+    /**
+     * @brief Fréquence d'échantillonnage de sortie (en Hz).
+     */
+    int frequence;
+
+    /**
+     * @brief Nombre maximal d'échantillons décodés par appel au décodeur.
+     */
+    size_t tailleMorceau;
+
+    /**
+     * @brief Indique que la fin du flux a été atteinte.
+     */
+    bool termine = false;
+
+public:
+    /**
+     * @brief Ouvre le fichier et alloue le tampon.
+     *
+     * @param fichier Chemin du fichier audio ou vidéo.
+     * @param frequence Fréquence d'échantillonnage de sortie (en Hz).
+     * @param capacite Capacité du tampon circulaire (en échantillons).
+     * @param tailleMorceau Taille des morceaux décodés (en échantillons).
+     */
+    LecteurAudioFlux(const string &fichier, int frequence, size_t capacite, size_t tailleMorceau);
+
+    /**
+     * @brief Se déplace dans le flux ; la position absolue du tampon devient secondes * frequence.
+     */
+    void chercher(double secondes);
+
+    /**
+     * @brief Décode jusqu'à disposer des échantillons antérieurs à une position absolue.
+     * @param position Position absolue à atteindre.
+     * @return false si la fin du flux survient avant cette position.
+     * @throws logic_error Si la capacité du tampon ne permet pas d'atteindre la position.
+     */
+    bool remplir(int64_t position);
+
+    /**
+     * @brief Indique que la fin du flux a été atteinte.
+     */
+    bool estTermine() const;
+
+    /**
+     * @brief Accès en lecture au tampon circulaire.
+     */
+    const TamponCirculaire &obtenirTampon() const;
+
+    /**
+     * @brief Libère les échantillons antérieurs à une position absolue.
+     */
+    void liberer(int64_t position);
+};
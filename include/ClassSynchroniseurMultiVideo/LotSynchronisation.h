@@ -0,0 +1,103 @@
+#pragma once
+
+#include "PoolThreads.h"
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class LotSynchronisation
+ * @brief Enchaîne les travaux d'un lot (analyse puis encodage) sur un seul pool de threads partagé.
+ *
+ * Chaque travail passe par deux phases : l'analyse, dont les sous-tâches (une par vidéo) sont réparties
+ * par vol de tâches sur tout le pool, puis l'encodage. Le nombre de travaux dans chaque phase est borné
+ * séparément : pendant qu'un travail est encodé, l'analyse des suivants occupe les autres threads.
+ * Les travaux démarrent par priorité décroissante, puis dans l'ordre du lot.
+ *
+ * Un encodage est une seule tâche, qui bloque un thread du pool jusqu'à la fin du rendu : ses décodeurs
+ * et son encodeur tournent sur leurs propres threads, hors du pool, et l'appelant doit les borner.
+ */
+class LotSynchronisation {
+public:
+    /**
+     * @struct Travail
+     * @brief Une vidéo synchronisée à générer.
+     */
+    struct Travail {
+        string sortie; /**< Chemin de la vidéo générée. */
+        vector<string> videos; /**< Vidéos à synchroniser (la première sert de référence sans audio externe). */
+        string audioRef; /**< Audio de référence externe (vide pour la première vidéo). */
+        string fiche; /**< Fiche de synchronisation propre au travail (vide pour aucune). */
+        int priorite = 0; /**< Priorité (la plus haute démarre en premier). */
+        unsigned int parallelisme = 0; /**< Vidéos analysées simultanément pour ce travail (0 = réglage global). */
+    };
+
+    /**
+     * @brief Phase d'encodage d'un travail analysé ; retourne true si la vidéo a été générée.
+     */
+    using Encodage = move_only_function<bool()>;
+
+    /**
+     * @brief Phase d'analyse d'un travail : ses sous-tâches sont soumises au pool fourni.
+     * @return La phase d'encodage, qui reprend les résultats de l'analyse.
+     */
+    using Analyse = function<Encodage(const Travail &travail, PoolThreads &pool)>;
+
+private:
+    /**
+     * @brief Nombre maximal de travaux en cours d'analyse.
+     */
+    size_t analysesSimultanees;
+
+    /**
+     * @brief Nombre maximal de travaux en cours d'encodage.
+     */
+    size_t encodagesSimultanes;
+
+    /**
+     * @brief Nombre de threads du pool partagé (0 = nombre de cœurs disponibles).
+     */
+    size_t nombreThreads;
+
+public:
+    /**
+     * @brief Prépare l'ordonnancement d'un lot.
+     *
+     * @param analyses Nombre maximal de travaux analysés en même temps.
+     * @param encodages Nombre maximal de travaux encodés en même temps.
+     * @param threads Nombre de threads du pool partagé (0 pour le nombre de cœurs disponibles).
+     */
+    LotSynchronisation(size_t analyses, size_t encodages, size_t threads = 0);
+
+    /**
+     * @brief Exécute tous les travaux d'un lot.
+     *
+     * L'échec d'un travail (exception de l'analyse ou de l'encodage) n'interrompt pas les autres.
+     *
+     * @param travaux Travaux à exécuter.
+     * @param analyser Phase d'analyse, appelée depuis un thread du pool.
+     * @return La réussite de chaque travail, dans l'ordre du lot.
+     */
+    vector<bool> executer(const vector<Travail> &travaux, const Analyse &analyser) const;
+
+    /**
+     * @brief Lit un manifeste de lot.
+     *
+     * Une ligne par travail : la vidéo de sortie, des options facultatives, puis les vidéos à synchroniser.
+     * Les options sont priorite=N, parallelisme=N, audio=CHEMIN (référence externe) et fiche=CHEMIN.
+     * Les chemins contenant des espaces sont écrits entre guillemets ; les lignes vides et celles
+     * commençant par # sont ignorées. Par exemple :
+     *
+     *     concert.mp4 priorite=2 cam1.mp4 cam2.mp4 cam3.mp4
+     *     "clip final.mp4" audio=mix.wav fiche=clip.json "cam 1.mp4" cam2.mp4
+     *
+     * @param fichier Chemin du manifeste.
+     * @return Les travaux, dans l'ordre du manifeste.
+     * @throws runtime_error Si le manifeste est illisible ou si une ligne est incomplète.
+     */
+    static vector<Travail> lireManifeste(const string &fichier);
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Metriques
+ * @brief Mesure le temps et le travail de chaque étape du traitement, par fichier d'entrée.
+ *
+ * Une étape est mesurée par un objet Metriques::Etape, de sa construction à sa destruction : temps écoulé,
+ * temps CPU du thread, octets compressés lus, échantillons corrélés, retards évalués et pic de mémoire
+ * résidente du processus. Les compteurs de travail sont tenus par thread : les décodeurs et les moteurs
+ * de corrélation les incrémentent sans verrou, et chaque étape n'en retient que la variation pendant
+ * sa durée sur son propre thread. Le rapport est écrit en JSON, et optionnellement au format
+ * Chrome Trace (chrome://tracing, Perfetto) pour visualiser les étapes par thread.
+ */
+class Metriques {
+public:
+    /**
+     * @struct Compteurs
+     * @brief Travail effectué par un thread.
+     */
+    struct Compteurs {
+        int64_t octets = 0; /**< Octets compressés lus par les décodeurs. */
+        int64_t echantillons = 0; /**< Échantillons de référence corrélés. */
+        int64_t retards = 0; /**< Retards évalués par la corrélation. */
+    };
+
+    /**
+     * @struct Enregistrement
+     * @brief Étape terminée.
+     */
+    struct Enregistrement {
+        string nom; /**< Nom de l'étape. */
+        string entree; /**< Fichier traité (vide pour une étape globale). */
+        size_t thread; /**< Numéro du thread, dans l'ordre de première apparition. */
+        int64_t debut; /**< Début depuis la création des métriques (en microsecondes). */
+        int64_t duree; /**< Temps écoulé (en microsecondes). */
+        int64_t cpu; /**< Temps CPU du thread (en microsecondes). */
+        Compteurs travail; /**< Travail effectué pendant l'étape. */
+        int64_t memoireMax; /**< Pic de mémoire résidente du processus à la fin de l'étape (en octets). */
+    };
+
+    /**
+     * @class Etape
+     * @brief Mesure une étape de sa construction à sa destruction (sans effet si les métriques sont nulles).
+     */
+    class Etape {
+        /**
+         * @brief Métriques recevant l'enregistrement (nullptr si désactivées).
+         */
+        Metriques *metriques;
+
+        /**
+         * @brief Nom de l'étape et fichier traité.
+         */
+        string nom, entree;
+
+        /**
+         * @brief Instant de début.
+         */
+        chrono::steady_clock::time_point debut;
+
+        /**
+         * @brief Temps CPU du thread au début (en microsecondes).
+         */
+        int64_t cpuDebut = 0;
+
+        /**
+         * @brief Compteurs du thread au début.
+         */
+        Compteurs travailDebut;
+
+    public:
+        /**
+         * @brief Commence la mesure.
+         * @param metriques Métriques recevant l'enregistrement (nullptr pour ne rien mesurer).
+         * @param nom Nom de l'étape.
+         * @param entree Fichier traité (vide pour une étape globale).
+         */
+        Etape(Metriques *metriques, string nom, string entree = "");
+
+        /**
+         * @brief Termine la mesure et l'enregistre.
+         */
+        ~Etape();
+
+        Etape(const Etape &) = delete;
+
+        Etape &operator=(const Etape &) = delete;
+    };
+
+private:
+    /**
+     * @brief Travail du thread courant, incrémenté sans verrou.
+     */
+    static thread_local Compteurs compteurs;
+
+    /**
+     * @brief Origine des instants enregistrés.
+     */
+    chrono::steady_clock::time_point origine;
+
+    /**
+     * @brief Étapes terminées, dans l'ordre de fin.
+     */
+    vector<Enregistrement> enregistrements;
+
+    /**
+     * @brief Identifiants des threads déjà rencontrés (leur indice est leur numéro).
+     */
+    vector<size_t> threads;
+
+    /**
+     * @brief Protège les enregistrements et les threads.
+     */
+    mutable mutex verrou;
+
+    /**
+     * @brief Ajoute une étape terminée.
+     */
+    void enregistrer(Enregistrement enregistrement);
+
+public:
+    /**
+     * @brief Démarre l'horloge des métriques.
+     */
+    Metriques();
+
+    /**
+     * @brief Ajoute des octets compressés lus au thread courant.
+     */
+    static void compterOctets(int64_t octets) { compteurs.octets += octets; }
+
+    /**
+     * @brief Ajoute une corrélation au thread courant.
+     * @param echantillons Échantillons de référence corrélés pour chaque retard.
+     * @param retards Nombre de retards évalués.
+     */
+    static void compterCorrelation(int64_t echantillons, int64_t retards) {
+        compteurs.echantillons += echantillons;
+        compteurs.retards += retards;
+    }
+
+    /**
+     * @brief Retourne le temps CPU consommé par le thread courant (en microsecondes).
+     */
+    static int64_t tempsCPUThread();
+
+    /**
+     * @brief Retourne le temps CPU consommé par le processus (en microsecondes).
+     */
+    static int64_t tempsCPUProcessus();
+
+    /**
+     * @brief Retourne le pic de mémoire résidente du processus (en octets).
+     */
+    static int64_t memoireMaximale();
+
+    /**
+     * @brief Retourne une copie des étapes terminées.
+     */
+    vector<Enregistrement> obtenirEnregistrements() const;
+
+    /**
+     * @brief Écrit le rapport JSON : totaux du processus, étapes, et totaux par étape et par entrée.
+     * @param fichier Chemin du rapport.
+     * @throws runtime_error Si le fichier ne peut pas être écrit.
+     */
+    void ecrireJSON(const string &fichier) const;
+
+    /**
+     * @brief Écrit les étapes au format Chrome Trace (un événement complet par étape).
+     * @param fichier Chemin de la trace.
+     * @throws runtime_error Si le fichier ne peut pas être écrit.
+     */
+    void ecrireTrace(const string &fichier) const;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @struct NoyauxCorrelation
+ * @brief Noyaux vectorisés de produit scalaire et de corrélation glissante.
+ *
+ * Une implémentation par jeu d'instructions (AVX-512, AVX2/FMA, SSE2, scalaire) est compilée ;
+ * la meilleure version supportée par le processeur est choisie une seule fois, au premier appel
+ * de obtenir(), à partir de CPUID. Les noyaux n'effectuent aucun contrôle de bornes :
+ * les retards en bord de signal sont traités par correler(), hors de la boucle critique.
+ */
+struct NoyauxCorrelation {
+    /**
+     * @brief Signature d'un noyau de produit scalaire : somme_i a[i] * b[i] pour i dans [0, n[.
+     */
+    using ProduitScalaire = double (*)(const float *a, const float *b, size_t n);
+
+    /**
+     * @brief Signature d'un noyau de corrélation glissante.
+     *
+     * Calcule sortie[k] = somme_i ref[i] * cible[i + k] pour i dans [0, n[ et k dans [0, nbRetards[.
+     * La cible doit contenir au moins n + nbRetards - 1 échantillons.
+     */
+    using CorrelationGlissante = void (*)(const float *ref, const float *cible, size_t n, size_t nbRetards,
+                                          double *sortie);
+
+    const char *nom; /**< Nom du jeu d'instructions retenu (pour les traces). */
+    ProduitScalaire produitScalaire; /**< Noyau de produit scalaire. */
+    CorrelationGlissante correlationGlissante; /**< Noyau de corrélation glissante. */
+
+    /**
+     * @brief Retourne les noyaux les plus rapides supportés par le processeur courant.
+     */
+    static const NoyauxCorrelation &obtenir();
+
+    /**
+     * @brief Calcule c[k] = somme_i ref[i] * cible[i + k] pour k dans [retardMin, retardMax].
+     *
+     * Les retards pour lesquels la référence est entièrement couverte par la cible passent par le noyau
+     * de corrélation glissante ; les retards de bord utilisent le produit scalaire sur la partie commune.
+     *
+     * @param ref Signal de référence.
+     * @param cible Signal cible.
+     * @param retardMin Premier retard évalué (en échantillons, peut être négatif).
+     * @param retardMax Dernier retard évalué (inclus).
+     * @param sortie Reçoit retardMax - retardMin + 1 valeurs de corrélation.
+     */
+    void correler(span<const float> ref, span<const float> cible, ptrdiff_t retardMin, ptrdiff_t retardMax,
+                  vector<double> &sortie) const;
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class PoolThreads
+ * @brief Pool de threads de taille fixe à vol de tâches.
+ *
+ * Les tâches soumises depuis l'extérieur du pool passent par une file commune, par priorité décroissante
+ * puis dans l'ordre de soumission. Une tâche soumise depuis un thread du pool (sous-tâche) va dans la file
+ * propre à ce thread, qui la reprend en dernier arrivé, premier servi ; un thread inoccupé vole les plus
+ * anciennes sous-tâches des autres. Chaque tâche soumise renvoie un future qui transporte son résultat
+ * ou l'exception qu'elle a levée.
+ */
+class PoolThreads {
+    /**
+     * @brief Tâche en attente d'exécution.
+     */
+    using Tache = move_only_function<void()>;
+
+    /**
+     * @struct FileLocale
+     * @brief Sous-tâches soumises par un thread du pool.
+     */
+    struct FileLocale {
+        mutex verrou; /**< Protège la file (le propriétaire et les voleurs y accèdent). */
+        deque<Tache> taches; /**< Sous-tâches, les plus récentes à la fin. */
+    };
+
+    /**
+     * @brief Threads de travail.
+     */
+    vector<thread> travailleurs;
+
+    /**
+     * @brief File propre à chaque thread de travail.
+     */
+    vector<unique_ptr<FileLocale> > filesLocales;
+
+    /**
+     * @brief File commune, rangée par (-priorité, ordre de soumission).
+     */
+    map<pair<int, uint64_t>, Tache> taches;
+
+    /**
+     * @brief Numéro de la prochaine tâche soumise à la file commune.
+     */
+    uint64_t numeroSoumission = 0;
+
+    /**
+     * @brief Nombre de tâches en attente dans toutes les files.
+     */
+    size_t enAttente = 0;
+
+    /**
+     * @brief Protège la file commune, le compteur de tâches et l'indicateur d'arrêt.
+     */
+    mutex verrou;
+
+    /**
+     * @brief Réveille les threads lorsqu'une tâche arrive ou que le pool s'arrête.
+     */
+    condition_variable condition;
+
+    /**
+     * @brief Demande d'arrêt émise par le destructeur.
+     */
+    bool arret = false;
+
+    /**
+     * @brief Pool auquel appartient le thread courant (nul hors de tout pool).
+     */
+    static thread_local PoolThreads *poolCourant;
+
+    /**
+     * @brief Indice du thread courant dans son pool.
+     */
+    static thread_local size_t indiceCourant;
+
+    /**
+     * @brief Boucle exécutée par chaque thread de travail.
+     */
+    void executer(size_t indice);
+
+    /**
+     * @brief Range une tâche dans la file locale du thread courant, ou dans la file commune.
+     */
+    void deposer(Tache tache, int priorite);
+
+    /**
+     * @brief Prend la prochaine tâche du thread indice : sa file, puis la file commune, puis un vol.
+     * @param commune false pour ignorer la file commune (attente d'une sous-tâche).
+     * @return true si une tâche a été prise.
+     */
+    bool prendre(size_t indice, bool commune, Tache &tache);
+
+public:
+    /**
+     * @brief Démarre le pool.
+     * @param nombre Nombre de threads (0 pour le nombre de cœurs disponibles).
+     */
+    explicit PoolThreads(size_t nombre);
+
+    /**
+     * @brief Termine les tâches déjà soumises puis arrête les threads.
+     */
+    ~PoolThreads();
+
+    PoolThreads(const PoolThreads &) = delete;
+
+    PoolThreads &operator=(const PoolThreads &) = delete;
+
+    /**
+     * @brief Retourne le nombre de threads du pool.
+     */
+    size_t obtenirTaille() const;
+
+    /**
+     * @brief Soumet une tâche au pool.
+     * @param tache Fonction sans argument à exécuter.
+     * @param priorite Priorité dans la file commune (la plus haute passe en premier, ignorée pour une sous-tâche).
+     * @return Un future donnant accès au résultat de la tâche.
+     */
+    template<typename Fonction>
+    future<invoke_result_t<Fonction> > soumettre(Fonction &&tache, int priorite = 0) {
+        packaged_task<invoke_result_t<Fonction>()> paquet(std::forward<Fonction>(tache));
+        auto resultat = paquet.get_future();
+
+        deposer(std::move(paquet), priorite);
+        return resultat;
+    }
+
+    /**
+     * @brief Attend le résultat d'une tâche du pool.
+     *
+     * Depuis un thread du pool, les sous-tâches en attente sont exécutées pendant l'attente : une tâche
+     * qui attend ses propres sous-tâches ne bloque jamais le pool, même s'il n'a qu'un thread.
+     *
+     * @param resultat Future renvoyé par soumettre.
+     * @return Le résultat de la tâche (ou l'exception qu'elle a levée).
+     */
+    template<typename Resultat>
+    Resultat attendre(future<Resultat> &resultat) {
+        if (poolCourant == this) {
+            while (resultat.wait_for(chrono::seconds(0)) != future_status::ready) {
+                Tache tache;
+
+                if (prendre(indiceCourant, false, tache)) {
+                    tache();
+                } else {
+                    resultat.wait_for(chrono::milliseconds(1));
+                }
+            }
+        }
+
+        return resultat.get();
+    }
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+/**
+ * @struct ProfilEncodage
+ * @brief Réglages d'encodage de la vidéo générée.
+ *
+ * Trois profils prédéfinis couvrent les usages courants : un aperçu très rapide en basse résolution,
+ * un rendu équilibré (par défaut) et un master d'archive. Chaque champ peut ensuite être ajusté.
+ */
+struct ProfilEncodage {
+    /**
+     * @enum Parallelisme
+     * @brief Répartition du travail de l'encodeur entre ses threads.
+     */
+    enum class Parallelisme {
+        Images, /**< Plusieurs images encodées en parallèle : meilleur débit, latence de quelques images. */
+        Tranches /**< Chaque image découpée en tranches : latence minimale, compression un peu moins bonne. */
+    };
+
+    string nom = "equilibre"; /**< Nom du profil (pour les traces). */
+    string preset = "fast"; /**< Preset x264 (ultrafast, superfast, veryfast, faster, fast, medium, slow...). */
+    string reglage = "zerolatency"; /**< Option tune x264 (zerolatency, film...), vide pour aucune. */
+    string profil = "baseline"; /**< Profil H.264 (baseline, main, high) ; baseline pour la compatibilité. */
+    int crf = 23; /**< Qualité constante (0 à 51, plus petit = meilleur) ; ignoré si debitBinaire > 0. */
+    int debitBinaire = 0; /**< Débit cible (en kbit/s, 0 pour le mode qualité constante). */
+    int tailleGOP = 60; /**< Nombre maximal d'images entre deux images clés. */
+    int threads = 0; /**< Nombre de threads de l'encodeur (0 pour le choix automatique). */
+    Parallelisme parallelisme = Parallelisme::Images; /**< Répartition du travail entre les threads. */
+    double echelle = 1.0; /**< Facteur appliqué à la taille des tuiles (0.5 pour une demi-résolution). */
+    int imagesParSeconde = 30; /**< Cadence de sortie. */
+    bool decodageReduit = true; /**< Sources bien plus grandes ou rapides que la sortie : décodage réduit, échelle rapide. */
+    bool imagesBEcartees = false; /**< Avec decodageReduit, écarte aussi les images B des sources assez rapides. */
+
+    /**
+     * @brief Aperçu : ultrafast, demi-résolution, 15 images par seconde, découpage en tranches.
+     */
+    static ProfilEncodage apercu();
+
+    /**
+     * @brief Rendu courant : preset fast, CRF 23, pleine résolution, profil baseline et réglage zerolatency.
+     *
+     * Contrairement à l'ancienne commande ffmpeg, qui laissait ces choix à l'encodeur, ce profil borne le GOP
+     * à 60 images (-g 60, nécessaire au découpage de RenduSegmente) et répartit l'encodage par images
+     * (-thread_type frame), ce qui remplace les tranches choisies par zerolatency.
+     */
+    static ProfilEncodage equilibre();
+
+    /**
+     * @brief Master d'archive : preset slow, CRF 18, profil high, GOP long, sources décodées et mises à l'échelle
+     *        sans raccourci.
+     */
+    static ProfilEncodage archive();
+};
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <string>
+
+using namespace std;
+
+struct AVFormatContext;
+struct AVPacket;
+struct AVStream;
+
+/**
+ * @class RecopieAudio
+ * @brief Recopie sans réencodage la piste audio d'un fichier dans une sortie en cours d'écriture.
+ *
+ * Les paquets sont décalés sur la chronologie de sortie, lus au fil de l'écriture des images
+ * et entrelacés avec elles ; ceux qui tombent avant le zéro commun ou après la fin sont écartés.
+ */
+class RecopieAudio {
+    /**
+     * @brief Contexte de démultiplexage de la source audio.
+     */
+    AVFormatContext *entree = nullptr;
+
+    /**
+     * @brief Flux audio du fichier de sortie.
+     */
+    AVStream *flux = nullptr;
+
+    /**
+     * @brief Index du flux audio recopié dans la source (-1 une fois la recopie terminée).
+     */
+    int index = -1;
+
+    /**
+     * @brief Paquet lu d'avance, en attente de son instant d'écriture.
+     */
+    AVPacket *paquet = nullptr;
+
+    /**
+     * @brief Indique que paquet contient un paquet non encore écrit.
+     */
+    bool enAttente = false;
+
+    /**
+     * @brief Position de lecture et délai de l'audio recopié (en secondes).
+     */
+    double debutLecture, delai;
+
+    /**
+     * @brief Libère toutes les ressources FFmpeg.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Ouvre la source audio et se place au début de la partie recopiée.
+     *
+     * @param fichier Fichier source de l'audio.
+     * @param debutLecture Position de lecture à l'instant 0 de la sortie (en secondes).
+     * @param delai Silence avant le début de l'audio (en secondes).
+     * @throws runtime_error Si le fichier ne peut pas être ouvert ou ne contient pas d'audio.
+     */
+    RecopieAudio(const string &fichier, double debutLecture, double delai);
+
+    /**
+     * @brief Libère la source audio.
+     */
+    ~RecopieAudio();
+
+    RecopieAudio(const RecopieAudio &) = delete;
+
+    RecopieAudio &operator=(const RecopieAudio &) = delete;
+
+    /**
+     * @brief Crée le flux audio dans la sortie, avant l'écriture de son en-tête.
+     * @param sortie Contexte de multiplexage du fichier de sortie.
+     */
+    void ajouterFlux(AVFormatContext *sortie);
+
+    /**
+     * @brief Recopie les paquets audio jusqu'à un instant de sortie donné.
+     *
+     * @param sortie Contexte de multiplexage du fichier de sortie.
+     * @param jusqua Instant de sortie (en secondes).
+     * @param fin Instant de fin de la sortie (en secondes).
+     * @throws runtime_error En cas d'erreur de lecture ou d'écriture.
+     */
+    void recopier(AVFormatContext *sortie, double jusqua, double fin);
+};
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "ProfilEncodage.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct AVFormatContext;
+struct AVCodecContext;
+struct AVPacket;
+struct AVFrame;
+struct AVStream;
+
+class ArenaImages;
+class Metriques;
+class RecopieAudio;
+
+/**
+ * @class RenduMosaique
+ * @brief Génère la vidéo mosaïque dans le processus, sans ligne de commande ffmpeg.
+ *
+ * Chaque entrée est décodée par son propre thread, qui met ses images à l'échelle directement dans
+ * la région de sa tuile au sein de l'image de sortie partagée : aucune image intermédiaire n'est copiée.
+ * Les images de sortie proviennent d'une arène alignée allouée au démarrage (ArenaImages) et recyclée
+ * d'une image à l'autre, si bien que le régime établi n'alloue plus rien. Les tuiles sont accolées, comme
+ * avec xstack : seules les lignes de l'arène sont alignées. Le thread appelant encode chaque image
+ * dès que toutes ses tuiles sont prêtes, pendant que les entrées préparent déjà les suivantes.
+ * L'audio d'une entrée choisie est recopié sans réencodage.
+ */
+class RenduMosaique {
+public:
+    /**
+     * @struct Entree
+     * @brief Vidéo placée sur la chronologie de sortie.
+     */
+    struct Entree {
+        string chemin; /**< Chemin du fichier vidéo. */
+        double debutLecture; /**< Position de lecture à l'instant 0 de la sortie (en secondes). */
+        double delai; /**< Temps d'attente avant la première image (en secondes, tuile noire). */
+        double duree; /**< Durée lue dans le fichier (en secondes), la tuile redevenant noire ensuite. */
+        double vitesse = 1.0; /**< Secondes du fichier lues par seconde de sortie (1 + dérive de son horloge). */
+    };
+
+    /**
+     * @struct Statistiques
+     * @brief Débit de chaque étape du rendu.
+     */
+    struct Statistiques {
+        int64_t images; /**< Nombre d'images produites. */
+        double secondesTotal; /**< Durée totale du rendu. */
+        double secondesDecodage; /**< Temps de décodage, cumulé sur les threads d'entrée. */
+        double secondesMiseAEchelle; /**< Temps de mise à l'échelle, cumulé sur les threads d'entrée. */
+        double secondesEncodage; /**< Temps d'encodage et d'écriture (thread appelant). */
+    };
+
+private:
+    /**
+     * @struct Emplacement
+     * @brief Image de sortie en cours de composition.
+     */
+    struct Emplacement {
+        AVFrame *image = nullptr; /**< Image de sortie réutilisée. */
+        int64_t numero = -1; /**< Numéro de l'image de sortie en cours de composition dans cet emplacement. */
+        size_t tuilesRestantes = 0; /**< Tuiles non encore écrites. */
+    };
+
+    /**
+     * @brief Nombre d'images de sortie composées simultanément.
+     */
+    static constexpr size_t NOMBRE_EMPLACEMENTS = 4;
+
+    /**
+     * @brief Images supplémentaires de l'arène, pour celles que l'encodeur référence encore.
+     */
+    static constexpr size_t RESERVE_IMAGES = 4;
+
+    /**
+     * @brief Vidéos à assembler, dans l'ordre des tuiles.
+     */
+    vector<Entree> entrees;
+
+    /**
+     * @brief Dimensions d'une tuile (en pixels).
+     */
+    int largeurTuile, hauteurTuile;
+
+    /**
+     * @brief Nombre de colonnes et de lignes de la grille.
+     */
+    int colonnes, lignes;
+
+    /**
+     * @brief Réglages de l'encodeur et cadence de sortie.
+     */
+    ProfilEncodage profil;
+
+    /**
+     * @brief Fichier dont l'audio est recopié (vide pour une sortie muette).
+     */
+    string fichierAudio;
+
+    /**
+     * @brief Position de lecture et délai de l'audio recopié (en secondes).
+     */
+    double debutAudio = 0.0, delaiAudio = 0.0;
+
+    /**
+     * @brief Cœurs partagés entre les décodeurs des entrées, et de l'encodeur si le profil n'en fixe pas
+     *        (0 pour tous les cœurs disponibles).
+     */
+    int coeurs = 0;
+
+    /**
+     * @brief Images de sortie en cours de composition (numéro n dans l'emplacement n % NOMBRE_EMPLACEMENTS).
+     */
+    vector<Emplacement> emplacements;
+
+    /**
+     * @brief Mémoire des images de sortie.
+     */
+    unique_ptr<ArenaImages> arene;
+
+    /**
+     * @brief Protège les emplacements et l'indicateur d'abandon.
+     */
+    mutex verrou;
+
+    /**
+     * @brief Signale un emplacement libéré ou une tuile terminée.
+     */
+    condition_variable condition;
+
+    /**
+     * @brief Demande d'arrêt après une erreur.
+     */
+    bool abandon = false;
+
+    /**
+     * @brief Temps cumulés des threads d'entrée (en nanosecondes).
+     */
+    atomic<int64_t> nanosDecodage{0}, nanosMiseAEchelle{0};
+
+    /**
+     * @brief Métriques recevant les étapes (nullptr si désactivées).
+     */
+    Metriques *metriques = nullptr;
+
+    /**
+     * @brief Contexte de multiplexage du fichier de sortie.
+     */
+    AVFormatContext *sortie = nullptr;
+
+    /**
+     * @brief Encodeur vidéo.
+     */
+    AVCodecContext *encodeur = nullptr;
+
+    /**
+     * @brief Flux vidéo du fichier de sortie.
+     */
+    AVStream *fluxVideo = nullptr;
+
+    /**
+     * @brief Recopie de l'audio choisi (nulle pour une sortie muette).
+     */
+    unique_ptr<RecopieAudio> audio;
+
+    /**
+     * @brief Paquet réutilisé pour l'encodage.
+     */
+    AVPacket *paquet = nullptr;
+
+    /**
+     * @brief Boucle d'un thread d'entrée : décode et met à l'échelle chaque image dans sa tuile.
+     * @param indice Indice de l'entrée.
+     * @param nbImages Nombre d'images de sortie.
+     * @param threadsDecodeur Nombre de threads du décodeur de l'entrée.
+     */
+    void composerEntree(size_t indice, int64_t nbImages, int threadsDecodeur);
+
+    /**
+     * @brief Prépare un emplacement pour l'image de numéro donné et le confie aux threads d'entrée.
+     */
+    void preparerEmplacement(Emplacement &emplacement, int64_t numero);
+
+    /**
+     * @brief Ouvre le fichier de sortie, l'encodeur et la source audio.
+     */
+    void ouvrirSortie(const string &fichierSortie);
+
+    /**
+     * @brief Envoie une image à l'encodeur (nullptr pour le vider) et écrit les paquets produits.
+     */
+    void encoder(const AVFrame *image);
+
+    /**
+     * @brief Libère toutes les ressources FFmpeg.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Prépare le rendu d'une grille de vidéos.
+     *
+     * @param entrees Vidéos à assembler, dans l'ordre des tuiles (de gauche à droite, puis de haut en bas).
+     * @param largeurTuile Largeur d'une tuile (en pixels, paire).
+     * @param hauteurTuile Hauteur d'une tuile (en pixels, paire).
+     * @param profil Réglages de l'encodeur et cadence de sortie.
+     */
+    RenduMosaique(const vector<Entree> &entrees, int largeurTuile, int hauteurTuile, const ProfilEncodage &profil);
+
+    /**
+     * @brief Libère les ressources du rendu.
+     */
+    ~RenduMosaique();
+
+    RenduMosaique(const RenduMosaique &) = delete;
+
+    RenduMosaique &operator=(const RenduMosaique &) = delete;
+
+    /**
+     * @brief Choisit la piste audio recopiée dans la sortie.
+     *
+     * @param fichier Fichier source de l'audio.
+     * @param debutLecture Position de lecture à l'instant 0 de la sortie (en secondes).
+     * @param delai Silence avant le début de l'audio (en secondes).
+     */
+    void configurerAudio(const string &fichier, double debutLecture, double delai);
+
+    /**
+     * @brief Limite les cœurs alloués aux décodeurs, lorsque plusieurs rendus s'exécutent en même temps.
+     *
+     * L'encodeur est limité au même nombre de threads si ProfilEncodage::threads vaut 0.
+     *
+     * @param nombre Nombre de cœurs (0 pour tous les cœurs disponibles).
+     */
+    void configurerThreads(int nombre);
+
+    /**
+     * @brief Génère la vidéo.
+     *
+     * @param fichierSortie Chemin du fichier de sortie.
+     * @param duree Durée de la sortie (en secondes).
+     * @return Le débit de chaque étape.
+     * @throws runtime_error En cas d'erreur de décodage, d'encodage ou d'écriture.
+     */
+    Statistiques generer(const string &fichierSortie, double duree);
+
+    /**
+     * @brief Mesure les étapes dans des métriques partagées.
+     * @param metriques Métriques recevant les étapes (nullptr pour désactiver).
+     */
+    void configurerMetriques(Metriques *metriques);
+};
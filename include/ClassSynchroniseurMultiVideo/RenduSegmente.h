@@ -0,0 +1,168 @@
+#pragma once
+
+#include "ProfilEncodage.h"
+#include "RenduMosaique.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct AVFormatContext;
+struct AVPacket;
+struct AVStream;
+
+class Metriques;
+
+/**
+ * @class RenduSegmente
+ * @brief Génère la mosaïque par tranches de temps encodées en parallèle, puis assemblées sans réencodage.
+ *
+ * Au-delà de quelques threads, l'encodeur H.264 ne passe plus à l'échelle. La chronologie de sortie
+ * est donc découpée en segments dont la longueur est un multiple de la taille de GOP : chaque segment
+ * est rendu par son propre RenduMosaique, qui commence sur une image clé, et les segments s'exécutent
+ * en même temps en se partageant les cœurs. Les paquets des segments sont ensuite recopiés bout à bout
+ * dans le fichier final, décalés de l'instant de début de leur segment, et l'audio est recopié une seule
+ * fois sur toute la durée. Tous les segments étant encodés avec les mêmes réglages, leurs paramètres de
+ * flux sont identiques et le flux concaténé reste décodable d'un seul tenant ; l'assemblage le vérifie
+ * et échoue plutôt que de produire un fichier corrompu.
+ */
+class RenduSegmente {
+    /**
+     * @brief Vidéos à assembler, dans l'ordre des tuiles.
+     */
+    vector<RenduMosaique::Entree> entrees;
+
+    /**
+     * @brief Dimensions d'une tuile (en pixels).
+     */
+    int largeurTuile, hauteurTuile;
+
+    /**
+     * @brief Réglages de l'encodeur et cadence de sortie.
+     */
+    ProfilEncodage profil;
+
+    /**
+     * @brief Nombre de segments encodés en parallèle.
+     */
+    int nombreSegments;
+
+    /**
+     * @brief Fichier dont l'audio est recopié (vide pour une sortie muette).
+     */
+    string fichierAudio;
+
+    /**
+     * @brief Position de lecture et délai de l'audio recopié (en secondes).
+     */
+    double debutAudio = 0.0, delaiAudio = 0.0;
+
+    /**
+     * @brief Cœurs répartis entre les segments (0 pour tous les cœurs disponibles).
+     */
+    int coeurs = 0;
+
+    /**
+     * @brief Contexte de multiplexage du fichier final.
+     */
+    AVFormatContext *sortie = nullptr;
+
+    /**
+     * @brief Contexte de démultiplexage du segment en cours de recopie.
+     */
+    AVFormatContext *segment = nullptr;
+
+    /**
+     * @brief Flux vidéo du fichier final.
+     */
+    AVStream *fluxVideo = nullptr;
+
+    /**
+     * @brief Paquet réutilisé pour la recopie.
+     */
+    AVPacket *paquet = nullptr;
+
+    /**
+     * @brief Métriques recevant les étapes (nullptr si désactivées).
+     */
+    Metriques *metriques = nullptr;
+
+    /**
+     * @brief Ouvre un segment et retourne l'index de son flux vidéo.
+     */
+    int ouvrirSegment(const string &fichier);
+
+    /**
+     * @brief Recopie les segments bout à bout dans le fichier final, avec l'audio.
+     *
+     * @param fichiers Segments, dans l'ordre de la chronologie.
+     * @param debuts Numéro de la première image de chaque segment dans la sortie.
+     * @param fichierSortie Chemin du fichier final.
+     * @param duree Durée de la sortie (en secondes).
+     */
+    void assembler(const vector<string> &fichiers, const vector<int64_t> &debuts, const string &fichierSortie,
+                   double duree);
+
+    /**
+     * @brief Libère toutes les ressources FFmpeg.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Prépare le rendu segmenté d'une grille de vidéos.
+     *
+     * @param entrees Vidéos à assembler, dans l'ordre des tuiles (de gauche à droite, puis de haut en bas).
+     * @param largeurTuile Largeur d'une tuile (en pixels, paire).
+     * @param hauteurTuile Hauteur d'une tuile (en pixels, paire).
+     * @param profil Réglages de l'encodeur et cadence de sortie.
+     * @param nombreSegments Nombre de segments (au moins 2 pour un gain ; réduit si la sortie est trop courte).
+     */
+    RenduSegmente(const vector<RenduMosaique::Entree> &entrees, int largeurTuile, int hauteurTuile,
+                  const ProfilEncodage &profil, int nombreSegments);
+
+    /**
+     * @brief Libère les ressources du rendu.
+     */
+    ~RenduSegmente();
+
+    RenduSegmente(const RenduSegmente &) = delete;
+
+    RenduSegmente &operator=(const RenduSegmente &) = delete;
+
+    /**
+     * @brief Choisit la piste audio recopiée dans la sortie.
+     *
+     * @param fichier Fichier source de l'audio.
+     * @param debutLecture Position de lecture à l'instant 0 de la sortie (en secondes).
+     * @param delai Silence avant le début de l'audio (en secondes).
+     */
+    void configurerAudio(const string &fichier, double debutLecture, double delai);
+
+    /**
+     * @brief Génère la vidéo.
+     *
+     * Les segments sont écrits sous des noms temporaires inutilisés à côté du fichier de sortie, puis supprimés
+     * après l'assemblage.
+     *
+     * @param fichierSortie Chemin du fichier de sortie.
+     * @param duree Durée de la sortie (en secondes).
+     * @return Le débit de chaque étape, cumulé sur les segments (secondesTotal inclut l'assemblage).
+     * @throws runtime_error En cas d'erreur de décodage, d'encodage ou d'écriture.
+     */
+    RenduMosaique::Statistiques generer(const string &fichierSortie, double duree);
+
+    /**
+     * @brief Mesure les étapes dans des métriques partagées.
+     * @param metriques Métriques recevant les étapes (nullptr pour désactiver).
+     */
+    void configurerMetriques(Metriques *metriques);
+
+    /**
+     * @brief Limite les cœurs répartis entre les segments, lorsque plusieurs rendus s'exécutent en même temps.
+     * @param nombre Nombre de cœurs (0 pour tous les cœurs disponibles).
+     */
+    void configurerThreads(int nombre);
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+using namespace std;
+
+/**
+ * @struct ResultatDecalage
+ * @brief Décalage mesuré entre un signal de référence et un signal cible, avec la netteté de son pic.
+ *
+ * Convention : l'instant t de la référence correspond à l'instant t + decalage de la cible.
+ */
+struct ResultatDecalage {
+    double decalage = 0.0; /**< Décalage de la cible (en secondes, positif ou négatif). */
+    double confiance = 0.0; /**< Corrélation normalisée des signaux alignés (0 à 1, négative si non mesurée). */
+    double rapportPicLobes = 0.0; /**< Écart du pic à la moyenne des lobes secondaires, en écarts-types. */
+    double margeSecondPic = 0.0; /**< Avance relative du pic sur le meilleur lobe secondaire (0 à 1). */
+    double plageExploree = 0.0; /**< Demi-largeur de la plage de retards réellement parcourue (en secondes). */
+
+    /**
+     * @brief Calcule rapportPicLobes et margeSecondPic à partir d'une courbe de corrélation.
+     *
+     * Les lobes secondaires sont tous les retards de la courbe hors du lobe principal.
+     * Les deux scores restent nuls si la courbe est trop courte pour les estimer.
+     *
+     * @param courbe Corrélation pour chaque retard de la plage.
+     * @param indicePic Indice du pic dans la courbe.
+     * @param lobePrincipal Demi-largeur du lobe principal (en indices de la courbe).
+     */
+    void noterNettete(span<const double> courbe, size_t indicePic, size_t lobePrincipal);
+};
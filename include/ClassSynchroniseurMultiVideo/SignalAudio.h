@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class SignalAudio
+ * @brief Signal audio mono en lecture seule, possédé en mémoire ou projeté depuis un fichier.
+ *
+ * Les deux origines exposent la même vue contiguë sur les échantillons, ce qui permet de corréler
+ * un signal issu du cache disque sans le recopier.
+ */
+class SignalAudio {
+    /**
+     * @brief Échantillons possédés (signal décodé en mémoire).
+     */
+    vector<float> echantillons;
+
+    /**
+     * @brief Début de la projection mémoire (nullptr si le signal est possédé).
+     */
+    void *projection = nullptr;
+
+    /**
+     * @brief Taille de la projection mémoire (en octets).
+     */
+    size_t tailleProjection = 0;
+
+    /**
+     * @brief Vue sur les échantillons, quelle que soit leur origine.
+     */
+    span<const float> vue;
+
+    /**
+     * @brief Libère la projection mémoire éventuelle.
+     */
+    void liberer();
+
+public:
+    /**
+     * @brief Construit un signal vide.
+     */
+    SignalAudio() = default;
+
+    /**
+     * @brief Prend possession d'échantillons décodés en mémoire.
+     */
+    explicit SignalAudio(vector<float> &&echantillons);
+
+    /**
+     * @brief Projette en mémoire une zone d'échantillons float d'un fichier, sans la lire.
+     *
+     * @param fichier Chemin du fichier.
+     * @param decalage Position des échantillons dans le fichier (en octets).
+     * @param nombre Nombre d'échantillons.
+     * @return Le signal projeté.
+     * @throws runtime_error Si le fichier ne peut pas être projeté.
+     */
+    static SignalAudio projeter(const string &fichier, size_t decalage, size_t nombre);
+
+    /**
+     * @brief Libère les échantillons ou la projection.
+     */
+    ~SignalAudio();
+
+    SignalAudio(SignalAudio &&autre) noexcept;
+
+    SignalAudio &operator=(SignalAudio &&autre) noexcept;
+
+    SignalAudio(const SignalAudio &) = delete;
+
+    SignalAudio &operator=(const SignalAudio &) = delete;
+
+    /**
+     * @brief Vue en lecture seule sur les échantillons.
+     */
+    span<const float> obtenirEchantillons() const;
+};
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "CorrelateurFFT.h"
+#include "CorrelateurIncremental.h"
+#include "ResultatDecalage.h"
+#include "TamponCirculaire.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class SuiviDirect
+ * @brief Suit en continu le décalage de plusieurs sources audio en cours d'enregistrement.
+ *
+ * Chaque source (fichier en cours d'écriture, tube nommé, URL de flux) est décodée par son propre thread
+ * dans un tampon circulaire borné. Pour chaque cible, une première corrélation sur toute la plage
+ * (acquisition) trouve le décalage ; il est ensuite suivi par un CorrelateurIncremental restreint
+ * à ±plageSuivi, qui ne corrèle que les échantillons arrivés depuis la mise à jour précédente
+ * et oublie exponentiellement les plus anciens. Les décalages sont publiés à chaque période.
+ *
+ * La mémoire est fixée par la capacité des tampons : un lecteur en avance attend que les autres
+ * le rattrapent plutôt que d'accumuler des échantillons.
+ */
+class SuiviDirect {
+public:
+    /**
+     * @brief Reçoit chaque décalage mis à jour (indice de la cible, décalage mesuré).
+     *
+     * Appelé depuis le thread d'executer(). Retourner false arrête le suivi.
+     */
+    using Rappel = function<bool(size_t indice, const ResultatDecalage &resultat)>;
+
+private:
+    /**
+     * @struct Entree
+     * @brief Source lue en continu par son propre thread.
+     */
+    struct Entree {
+        string chemin; /**< Chemin ou URL de la source. */
+        TamponCirculaire tampon; /**< Échantillons décodés et pas encore libérés. */
+        int64_t limite = numeric_limits<int64_t>::max(); /**< Position avant laquelle libérer les échantillons. */
+        atomic<bool> termine = false; /**< Le flux est terminé (ou n'a pas pu être ouvert). */
+        string erreur; /**< Message de l'erreur qui a terminé le flux (vide si aucune). */
+        mutex verrou; /**< Protège le tampon, la limite et l'erreur. */
+        condition_variable place; /**< Réveille le lecteur lorsque la limite avance. */
+        thread lecteur; /**< Thread de décodage. */
+
+        Entree(const string &chemin, size_t capacite) : chemin(chemin), tampon(capacite) {
+        }
+    };
+
+    /**
+     * @struct Poursuite
+     * @brief État du suivi d'une cible.
+     */
+    struct Poursuite {
+        unique_ptr<CorrelateurIncremental> correlateur; /**< Corrélation suivie (nulle pendant l'acquisition). */
+        ptrdiff_t retardMin = 0; /**< Premier retard suivi (en échantillons). */
+        ptrdiff_t retardMax = 0; /**< Dernier retard suivi (inclus). */
+        int64_t traitesRef = 0; /**< Position de référence jusqu'à laquelle la corrélation est à jour. */
+        int64_t traitesCible = 0; /**< Position de cible jusqu'à laquelle la corrélation est à jour. */
+        int64_t prochaineAcquisition = 0; /**< Fin de référence à attendre avant une nouvelle acquisition. */
+        double energieRef = 0.0; /**< Énergie de la référence corrélée, atténuée comme la corrélation. */
+        double energieCible = 0.0; /**< Énergie de la cible corrélée, atténuée comme la corrélation. */
+    };
+
+    /**
+     * @brief État d'une entrée relevé au début d'une mise à jour.
+     */
+    struct Etat {
+        int64_t debut; /**< Plus ancienne position disponible. */
+        int64_t fin; /**< Position suivant le dernier échantillon reçu. */
+        bool termine; /**< Plus aucun échantillon n'arrivera. */
+    };
+
+    /**
+     * @brief Fréquence d'échantillonnage de l'analyse (en Hz).
+     */
+    int frequence;
+
+    /**
+     * @brief Demi-largeur de la plage de l'acquisition (en échantillons).
+     */
+    int64_t plage;
+
+    /**
+     * @brief Demi-largeur de la plage suivie autour du décalage acquis (en échantillons).
+     */
+    int64_t plageSuivi;
+
+    /**
+     * @brief Durée corrélée par l'acquisition et constante de temps de l'oubli (en échantillons).
+     */
+    int64_t memoire;
+
+    /**
+     * @brief Intervalle entre deux mises à jour (en secondes).
+     */
+    double periode;
+
+    /**
+     * @brief Rapport pic sur lobes exigé pour acquérir un décalage (la moitié suffit pour le conserver).
+     */
+    double seuil;
+
+    /**
+     * @brief Nombre d'échantillons décodés par lecture.
+     */
+    size_t tailleMorceau;
+
+    /**
+     * @brief Capacité du tampon de chaque entrée (en échantillons).
+     */
+    size_t capacite;
+
+    /**
+     * @brief Demi-largeur du lobe principal exclue des lobes secondaires (en secondes).
+     */
+    static constexpr double DUREE_LOBE_PRINCIPAL = 0.01;
+
+    /**
+     * @brief Entrées lues : la référence, puis les cibles.
+     */
+    vector<unique_ptr<Entree> > entrees;
+
+    /**
+     * @brief Suivi de chaque cible.
+     */
+    vector<Poursuite> poursuites;
+
+    /**
+     * @brief Moteur de l'acquisition, réutilisé d'une tentative à l'autre.
+     */
+    CorrelateurFFT correlateurAcquisition;
+
+    /**
+     * @brief Tampons de travail des mises à jour.
+     */
+    vector<float> bloc, segment;
+
+    /**
+     * @brief Demande d'arrêt, consultée par les lecteurs et par FFmpeg pendant ses attentes.
+     */
+    atomic<bool> arret = false;
+
+    /**
+     * @brief Protège l'attente de la boucle principale.
+     */
+    mutex verrouReveil;
+
+    /**
+     * @brief Réveille la boucle principale lors d'un arrêt.
+     */
+    condition_variable reveil;
+
+    /**
+     * @brief Boucle d'un thread de lecture : décode la source dans son tampon jusqu'à la fin du flux.
+     */
+    void lire(Entree &entree);
+
+    /**
+     * @brief Relève les positions disponibles d'une entrée.
+     */
+    Etat observer(Entree &entree);
+
+    /**
+     * @brief Copie taille échantillons d'une entrée depuis position, avec des zéros à partir de fin.
+     */
+    void extraire(Entree &entree, int64_t position, size_t taille, int64_t fin, vector<float> &sortie);
+
+    /**
+     * @brief Cherche le décalage d'une cible sur toute la plage, puis amorce son suivi.
+     * @return true si un décalage a été acquis et noté dans resultat.
+     */
+    bool acquerir(size_t indice, const Etat &etatRef, const Etat &etatCible, ResultatDecalage &resultat);
+
+    /**
+     * @brief Corrèle les échantillons reçus depuis la mise à jour précédente.
+     * @return true si le décalage suivi a été noté dans resultat.
+     */
+    bool poursuivre(size_t indice, const Etat &etatRef, const Etat &etatCible, ResultatDecalage &resultat);
+
+    /**
+     * @brief Note le pic de la corrélation suivie ; revient à l'acquisition s'il n'est plus fiable.
+     * @return true si le pic est fiable.
+     */
+    bool evaluer(Poursuite &poursuite, ResultatDecalage &resultat);
+
+    /**
+     * @brief Fixe les positions que les lecteurs peuvent libérer, d'après les besoins de chaque cible.
+     */
+    void fixerLimites(const vector<Etat> &etats);
+
+    /**
+     * @brief Arrête et attend tous les lecteurs.
+     */
+    void rejoindre();
+
+public:
+    /**
+     * @brief Prépare le suivi d'une référence et de ses cibles.
+     *
+     * @param fichierRef Source de référence (fichier en cours d'écriture, tube nommé ou URL).
+     * @param fichiersCibles Sources à synchroniser.
+     * @param frequence Fréquence de l'analyse (en Hz).
+     * @param plage Plage de l'acquisition (en secondes).
+     * @param periode Intervalle entre deux publications (en secondes).
+     * @param memoire Durée corrélée par l'acquisition et constante de temps de l'oubli (en secondes).
+     * @param plageSuivi Écart suivi autour du décalage acquis (en secondes).
+     * @param seuil Rapport pic sur lobes exigé pour acquérir un décalage.
+     */
+    SuiviDirect(const string &fichierRef, const vector<string> &fichiersCibles, int frequence, double plage,
+                double periode, double memoire, double plageSuivi, double seuil);
+
+    /**
+     * @brief Arrête les lecteurs encore actifs.
+     */
+    ~SuiviDirect();
+
+    SuiviDirect(const SuiviDirect &) = delete;
+
+    SuiviDirect &operator=(const SuiviDirect &) = delete;
+
+    /**
+     * @brief Lit les sources et publie les décalages jusqu'à la fin de tous les flux ou jusqu'à l'arrêt.
+     *
+     * Un tube nommé n'est ouvert qu'une fois son écrivain connecté : l'arrêt attend cette ouverture.
+     *
+     * @param rappel Reçoit chaque décalage mis à jour.
+     * @throws runtime_error Si une source n'a pas pu être ouverte ou décodée.
+     */
+    void executer(const Rappel &rappel);
+
+    /**
+     * @brief Demande l'arrêt du suivi (depuis n'importe quel thread, y compris le rappel).
+     */
+    void arreter();
+};
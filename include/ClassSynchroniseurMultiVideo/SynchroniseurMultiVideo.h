@@ -1,16 +1,44 @@
 #pragma once
 
+#include "Chronologie.h"
+#include "IndexEmpreintes.h"
+#include "LotSynchronisation.h"
+#include "Metriques.h"
+#include "ProfilEncodage.h"
+#include "ResultatDecalage.h"
+#include "SignalAudio.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 using namespace std;
 
+/**
+ * @enum MethodeCorrelation
+ * @brief Moteur utilisé pour estimer le décalage entre deux signaux audio.
+ */
+enum class MethodeCorrelation {
+    Directe, /**< Boucle de corrélation échantillonnée (un retard sur 20, pas de pasDePrecision). */
+    FFT, /**< Corrélation complète par FFT, exacte à l'échantillon près, en O(n log n). */
+    Hierarchique, /**< Recherche grossière sur signaux décimés puis affinage sub-échantillon autour des meilleurs pics. */
+    Empreinte /**< Vote de repères spectraux, sans limite de plage, puis affinage sub-échantillon autour du retard voté. */
+};
+
 /**
  * @class SynchroniseurMultiVideo
  * @brief Classe permettant de synchroniser plusieurs vidéos basées sur leur piste audio.
  *
  * Cette classe analyse les pistes audio de plusieurs fichiers vidéo pour déterminer
  * le décalage temporel entre elles et générer une vidéo synchronisée (par exemple, une vue mosaïque).
+ *
+ * Une fois configurée, une instance peut être partagée entre threads : les méthodes const ne modifient
+ * aucun état partagé et n'utilisent aucun fichier temporaire à nom fixe. Seuls les rapports de métriques
+ * supposent une génération à la fois par instance.
  */
 class SynchroniseurMultiVideo {
     /**
@@ -33,6 +61,131 @@ class SynchroniseurMultiVideo {
     */
     int pasDePrecision = 100;
 
+    /**
+     * @brief Moteur de corrélation utilisé par calculerDecalage.
+     */
+    MethodeCorrelation methodeCorrelation = MethodeCorrelation::FFT;
+
+    /**
+     * @brief Nombre maximal de vidéos analysées en parallèle (0 = nombre de cœurs disponibles).
+     */
+    unsigned int nombreThreads = 0;
+
+    /**
+     * @brief Fréquence approximative des signaux décimés de la recherche hiérarchique (en Hz).
+     */
+    int frequenceGrossiere = 4000;
+
+    /**
+     * @brief Nombre de pics candidats affinés à pleine résolution par la recherche hiérarchique.
+     */
+    int nombreCandidats = 5;
+
+    /**
+     * @brief Recherche progressive : la plage s'élargit autour du décalage a priori jusqu'à un pic net.
+     */
+    bool rechercheProgressive = false;
+
+    /**
+     * @brief Demi-largeur de la première plage de la recherche progressive (en secondes).
+     */
+    double fenetreInitiale = 2.0;
+
+    /**
+     * @brief Rapport pic sur lobes à partir duquel la recherche progressive s'arrête.
+     */
+    double seuilRapportPicLobes = 12.0;
+
+    /**
+     * @brief Demi-largeur du lobe principal, exclue des lobes secondaires lors de la notation d'un pic (en secondes).
+     */
+    const double DUREE_LOBE_PRINCIPAL = 0.01;
+
+    /**
+     * @brief Nombre minimal de repères concordants pour accepter le retard voté par empreintes.
+     */
+    int votesMinimum = 8;
+
+    /**
+     * @brief Durée maximale du segment corrélé pour affiner le retard voté par empreintes (en secondes).
+     */
+    const int DUREE_AFFINAGE_EMPREINTE = 10;
+
+    /**
+     * @brief Demi-largeur de la courbe notée autour du retard voté par empreintes (en largeurs de lobe principal).
+     */
+    const int LOBES_NOTATION_EMPREINTE = 8;
+
+    /**
+     * @brief Budget mémoire de l'analyse en flux (en octets, 0 = analyse en mémoire).
+     */
+    size_t memoireFlux = 0;
+
+    /**
+     * @brief Instants de début des fenêtres analysées en flux (en secondes depuis le début de la référence).
+     */
+    vector<double> debutsFenetres = {0.0};
+
+    /**
+     * @brief Nombre d'échantillons décodés par morceau lors de l'analyse en flux.
+     */
+    const size_t TAILLE_MORCEAU_FLUX = 16384;
+
+    /**
+     * @brief Dossier du cache des signaux d'analyse (vide = cache désactivé).
+     */
+    string dossierCache;
+
+    /**
+     * @brief Alignement global : toutes les paires de fichiers sont corrélées, puis une chronologie commune est résolue.
+     */
+    bool alignementGlobal = false;
+
+    /**
+     * @brief Confiance minimale d'une mesure de paire pour participer à l'alignement global.
+     */
+    double confianceMinimale = 0.1;
+
+    /**
+     * @brief Écart au-delà duquel une mesure de paire contredit la chronologie globale (en secondes).
+     */
+    const double TOLERANCE_ALIGNEMENT = 0.05;
+
+    /**
+     * @brief Suivi de la dérive d'horloge de chaque vidéo sur toute sa durée.
+     */
+    bool suiviDerive = false;
+
+    /**
+     * @brief Durée des fenêtres corrélées par le suivi de dérive (en secondes).
+     */
+    double dureeFenetreDerive = 5.0;
+
+    /**
+     * @brief Écart entre deux fenêtres du suivi de dérive (en secondes).
+     */
+    double intervalleDerive = 30.0;
+
+    /**
+     * @brief Écart maximal cherché autour du décalage constant par le suivi de dérive (en secondes).
+     */
+    const double PLAGE_DERIVE = 0.5;
+
+    /**
+     * @brief Limite la sortie à la partie commune à toutes les entrées (sinon, couvre l'union des entrées).
+     */
+    bool recouvrementSeul = true;
+
+    /**
+     * @brief Génère la vidéo dans le processus plutôt que par la ligne de commande ffmpeg.
+     */
+    bool renduNatif = true;
+
+    /**
+     * @brief Nombre de segments encodés en parallèle par le rendu natif (1 pour un seul encodeur).
+     */
+    int segmentsRendu = 1;
+
     /**
      * @brief Hauteur cible pour le redimensionnement des vidéos (en pixels).
      */
@@ -44,14 +197,71 @@ class SynchroniseurMultiVideo {
     const int LARGEUR_CIBLE = 854;
 
     /**
-     * @brief Nom du fichier temporaire pour l'audio de référence.
+     * @brief Réglages d'encodage de la vidéo générée (taille des tuiles, cadence, encodeur).
+     */
+    ProfilEncodage profilEncodage;
+
+    /**
+     * @brief Fiche de synchronisation à écrire avec la vidéo (vide = aucune).
+     */
+    string ficheSynchro;
+
+    /**
+     * @brief N'écrire que la fiche de synchronisation, sans encoder de vidéo.
+     */
+    bool ficheSeulement = false;
+
+    /**
+     * @brief Fréquence d'analyse du suivi en direct (en Hz), abaissée pour tenir le temps réel.
+     */
+    int frequenceDirect = 8000;
+
+    /**
+     * @brief Intervalle entre deux publications du suivi en direct (en secondes).
+     */
+    double periodeDirect = 0.25;
+
+    /**
+     * @brief Durée corrélée par l'acquisition et constante de temps de l'oubli du suivi en direct (en secondes).
+     */
+    double memoireDirect = 10.0;
+
+    /**
+     * @brief Écart suivi autour du décalage acquis par le suivi en direct (en secondes).
+     */
+    double plageSuiviDirect = 1.0;
+
+    /**
+     * @brief Nombre maximal de travaux d'un lot analysés en même temps.
+     */
+    size_t analysesLot = 2;
+
+    /**
+     * @brief Nombre maximal de travaux d'un lot encodés en même temps.
+     */
+    size_t encodagesLot = 1;
+
+    /**
+     * @brief Cœurs alloués à la génération d'une vidéo (0 pour tous), fixés par genererLot pour chaque encodage.
+     */
+    int coeursRendu = 0;
+
+    /**
+     * @brief Rapport JSON des métriques d'exécution (vide = aucun).
      */
-    const string TEMP_AUDIO_REF = "temp_ref.raw";
+    string fichierMetriques;
 
     /**
-     * @brief Nom du fichier temporaire pour l'audio cible.
+     * @brief Trace Chrome des étapes (vide = aucune).
+     */
+    string fichierTrace;
+
+    /**
+     * @brief Métriques de l'exécution en cours (nulles si aucun rapport n'est demandé).
+     *
+     * Recréées au début de chaque génération ; les étapes y écrivent depuis tous les threads.
      */
-    const string TEMP_AUDIO_CIBLE = "temp_cible.raw";
+    mutable shared_ptr<Metriques> metriques;
 
     /**
      * @struct InfoVideo
@@ -60,46 +270,271 @@ class SynchroniseurMultiVideo {
     struct InfoVideo {
         string chemin; /**< Chemin d'accès au fichier vidéo. */
         double retardSecondes; /**< Retard calculé en secondes par rapport à la vidéo de référence. */
+        double confiance = 1.0; /**< Confiance de l'alignement (corrélation normalisée, 0 à 1). */
+        double derive = 0.0; /**< Dérive d'horloge : secondes de la vidéo gagnées par seconde de référence. */
+    };
+
+    /**
+     * @struct CourbeRetards
+     * @brief Courbe de corrélation produite par une recherche, sur une grille régulière de retards.
+     */
+    struct CourbeRetards {
+        vector<double> valeurs; /**< Corrélation de chaque retard de la grille. */
+        int premierRetard = 0; /**< Retard du premier point (en échantillons). */
+        int pas = 1; /**< Écart entre deux points de la grille (en échantillons). */
     };
 
     /**
-     * @brief Extrait la piste audio d'un fichier vidéo vers un fichier brut.
+     * @brief Décode la piste audio d'un fichier en mémoire.
+     *
+     * Utilise les bibliothèques FFmpeg pour démultiplexer uniquement le flux audio, le convertir
+     * en mono, float 32 bits, à la fréquence d'échantillonnage définie, sur les dureeAnalyse premières secondes.
+     * Aucun processus externe ni fichier temporaire n'est utilisé.
+     *
+     * @param fichier Chemin du fichier audio ou vidéo source.
+     * @param sortie Vecteur recevant les échantillons (sa capacité est réutilisée).
+     * @throws runtime_error Si le décodage échoue.
+     */
+    void chargerAudio(const string &fichier, vector<float> &sortie) const;
+
+    /**
+     * @brief Retourne le signal d'analyse d'un fichier, depuis le cache si possible.
+     *
+     * Si le cache est activé et contient une entrée valide pour ce fichier et ces paramètres,
+     * elle est projetée en mémoire sans décodage. Sinon l'audio est décodé puis enregistré dans le cache.
+     *
+     * @param fichier Chemin du fichier audio ou vidéo source.
+     * @return Le signal d'analyse.
+     * @throws runtime_error Si le décodage échoue.
+     */
+    SignalAudio obtenirSignal(const string &fichier) const;
+
+    /**
+     * @brief Calcule le décalage temporel entre deux signaux audio et note la netteté du pic trouvé.
+     *
+     * Compare le tiers central du signal de référence au signal cible pour chaque retard de la
+     * plage de recherche, centrée sur le décalage a priori, avec le moteur choisi par methodeCorrelation.
+     * En recherche progressive, la plage part de fenetreInitiale et quadruple tant que le pic trouvé
+     * n'atteint pas seuilRapportPicLobes ou touche le bord de la plage (sauf par empreintes, déjà sans limite).
+     *
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param indexRef Index d'empreintes de la référence, partagé entre les cibles (construit à la volée si absent).
+     * @param aPriori Décalage attendu, par exemple le dernier connu (en secondes).
+     * @return Le décalage et ses scores.
+     * @throws runtime_error Si un signal est vide ou si le moteur ne trouve aucun retard.
+     */
+    ResultatDecalage calculerDecalage(span<const float> ref, span<const float> cible,
+                                      const IndexEmpreintes *indexRef = nullptr, double aPriori = 0.0) const;
+
+    /**
+     * @brief Note le pic de corrélation d'un retard sur la courbe produite par la recherche.
+     *
+     * Les lobes secondaires sont tous les points de la courbe hors de ±DUREE_LOBE_PRINCIPAL autour du pic.
+     *
+     * @param courbe Courbe de la recherche qui a trouvé le retard.
+     * @param retard Retard trouvé (en échantillons).
+     * @param resultat Reçoit le rapport pic sur lobes et la marge sur le second pic (nuls si la courbe est vide).
+     */
+    void noterPic(const CourbeRetards &courbe, double retard, ResultatDecalage &resultat) const;
+
+    /**
+     * @brief Recherche le meilleur retard par corrélation directe échantillonnée.
      *
-     * Utilise FFmpeg pour extraire l'audio, le convertir en mono, float 32-bit little-endian,
-     * à la fréquence d'échantillonnage définie.
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param centre Centre de la plage de retards (en échantillons).
+     * @param plage Demi-largeur de la plage de retards (en échantillons).
+     * @param courbe Reçoit la corrélation de chaque retard évalué (un sur 20).
+     * @return Le meilleur retard en échantillons.
+     */
+    int chercherRetardDirect(span<const float> ref, span<const float> cible, int centre, int plage,
+                             CourbeRetards &courbe) const;
+
+    /**
+     * @brief Recherche le meilleur retard en calculant la corrélation complète par FFT.
      *
-     * @param fichierVideo Chemin du fichier vidéo source.
-     * @param fichierAudioSortie Chemin du fichier audio de sortie (format brut).
-     * @throws runtime_error Si l'extraction échoue.
+     * Tous les retards de la plage sont évalués, sans sous-échantillonnage.
+     *
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param centre Centre de la plage de retards (en échantillons).
+     * @param plage Demi-largeur de la plage de retards (en échantillons).
+     * @param courbe Reçoit la corrélation de chaque retard de la plage.
+     * @return Le meilleur retard en échantillons.
      */
-    void extraireAudio(const string &fichierVideo, const string &fichierAudioSortie) const;
+    int chercherRetardFFT(span<const float> ref, span<const float> cible, int centre, int plage,
+                          CourbeRetards &courbe) const;
 
     /**
-     * @brief Charge des données audio brutes depuis un fichier.
+     * @brief Recherche le meilleur retard du grossier au fin.
      *
-     * Lit un fichier binaire contenant des échantillons audio au format float.
+     * Les deux signaux sont filtrés et décimés vers frequenceGrossiere, corrélés par FFT sur toute la plage,
+     * puis seuls les nombreCandidats meilleurs pics sont réévalués à pleine fréquence dans une petite fenêtre.
+     * Le pic retenu est enfin affiné par interpolation parabolique.
      *
-     * @param nomFichier Chemin du fichier audio brut.
-     * @return Un vecteur de flottants représentant les échantillons audio.
-     * @throws runtime_error Si le fichier ne peut pas être ouvert ou lu.
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param centre Centre de la plage de retards (en échantillons).
+     * @param plage Demi-largeur de la plage de retards (en échantillons).
+     * @param courbe Reçoit la corrélation grossière de toute la plage.
+     * @return Le meilleur retard en échantillons, avec une précision inférieure à l'échantillon.
      */
-    static vector<float> chargerAudioBrut(const string &nomFichier);
+    double chercherRetardHierarchique(span<const float> ref, span<const float> cible, int centre, int plage,
+                                      CourbeRetards &courbe) const;
 
     /**
-     * @brief Calcule le décalage temporel entre deux signaux audio.
+     * @brief Recherche le meilleur retard par vote d'empreintes spectrales.
      *
-     * Utilise une méthode de corrélation croisée simplifiée pour estimer le décalage
-     * temporel entre le signal de référence et le signal cible.
+     * Le retard voté, précis à une trame près, est ensuite affiné à pleine fréquence sur une portion
+     * de la zone de recouvrement des deux signaux. La plage de recherche n'est pas limitée.
      *
-     * @param ref Vecteur des échantillons de l'audio de référence.
-     * @param cible Vecteur des échantillons de l'audio à synchroniser.
-     * @return Le décalage en secondes (positif ou négatif). Retourne 0.0 en cas d'erreur.
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param indexRef Index d'empreintes construit sur ref.
+     * @param courbe Reçoit la corrélation du segment affiné à ±LOBES_NOTATION_EMPREINTE lobes du retard trouvé.
+     * @return Le meilleur retard en échantillons, avec une précision inférieure à l'échantillon.
+     * @throws runtime_error Si trop peu de repères concordent.
      */
-    double calculerDecalage(const vector<float> &ref, const vector<float> &cible) const;
+    double chercherRetardEmpreinte(span<const float> ref, span<const float> cible, const IndexEmpreintes &indexRef,
+                                   CourbeRetards &courbe) const;
+
+    /**
+     * @brief Réévalue des retards candidats à pleine fréquence et retient le meilleur.
+     *
+     * Chaque candidat est corrélé exactement dans une fenêtre de ±demiFenetre échantillons,
+     * puis le pic retenu est affiné par interpolation parabolique.
+     *
+     * @param segmentRef Portion de la référence corrélée.
+     * @param debutSegment Position du segment dans la référence (un retard r correspond à l'indice debutSegment + r de la cible).
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param retardsCandidats Retards approximatifs à affiner (en échantillons).
+     * @param demiFenetre Demi-largeur de la fenêtre d'affinage (en échantillons).
+     * @param retardMinimal Plus petit retard admis (en échantillons).
+     * @param retardMaximal Plus grand retard admis (en échantillons).
+     * @return Le meilleur retard en échantillons, avec une précision inférieure à l'échantillon.
+     */
+    double affinerRetard(span<const float> segmentRef, int debutSegment, span<const float> cible,
+                         const vector<int> &retardsCandidats, int demiFenetre, int retardMinimal,
+                         int retardMaximal) const;
+
+    /**
+     * @brief Calcule le décalage entre deux fichiers en lisant leur audio en flux.
+     *
+     * Pour chaque fenêtre de debutsFenetres, la référence est lue par blocs sur dureeAnalyse secondes,
+     * avec la portion de cible correspondante élargie de plageRechercheMax de chaque côté. Les corrélations
+     * des blocs et des fenêtres sont accumulées. La taille des blocs est choisie pour respecter le budget
+     * mémoire, indépendamment de la durée des fichiers.
+     *
+     * @param fichierRef Chemin du fichier de référence.
+     * @param fichierCible Chemin du fichier à synchroniser.
+     * @param memoireMax Budget mémoire de l'analyse (en octets).
+     * @return Le décalage en secondes (positif ou négatif).
+     * @throws runtime_error Si le budget ne permet pas de couvrir la plage de recherche ou si la lecture échoue.
+     */
+    double calculerDecalageFlux(const string &fichierRef, const string &fichierCible, size_t memoireMax) const;
+
+    /**
+     * @brief Décode et corrèle chaque vidéo cible avec la référence, en parallèle.
+     *
+     * Chaque vidéo est traitée par une tâche indépendante sur un pool borné à nombreThreads,
+     * avec son propre tampon audio. En analyse en mémoire, la référence est décodée une seule fois
+     * et partagée en lecture sans copie ; en analyse en flux, chaque tâche lit la référence par blocs
+     * avec une part égale du budget mémoire. Les vidéos en échec sont ignorées ; les autres sont
+     * retournées dans l'ordre d'entrée.
+     *
+     * Avec un pool partagé (traitement par lots), les tâches y sont soumises comme sous-tâches,
+     * au plus nombreThreads à la fois.
+     *
+     * @param fichierRef Chemin du fichier de référence (audio ou vidéo).
+     * @param fichiersVideo Chemins des vidéos à analyser.
+     * @param premierNumero Numéro affiché pour la première vidéo de la liste.
+     * @param pool Pool partagé à utiliser (nul pour un pool propre à l'analyse).
+     * @return Les vidéos analysées avec leur décalage.
+     * @throws runtime_error Si la référence ne peut pas être décodée.
+     */
+    vector<InfoVideo> analyserCibles(const string &fichierRef, const vector<string> &fichiersVideo,
+                                     int premierNumero, PoolThreads *pool = nullptr) const;
+
+    /**
+     * @brief Mesure la ressemblance de deux signaux alignés avec un décalage donné.
+     *
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param decalage Décalage de la cible (en secondes).
+     * @return La corrélation normalisée sur la partie commune des deux signaux (0 à 1).
+     */
+    double mesurerConfiance(span<const float> ref, span<const float> cible, double decalage) const;
+
+    /**
+     * @brief Aligne la référence et les vidéos cibles sur une chronologie globale.
+     *
+     * Tous les signaux sont décodés une seule fois, en parallèle, puis chaque paire de fichiers est corrélée
+     * par une tâche du pool qui partage ces signaux en lecture. Les décalages et confiances des paires sont
+     * enfin combinés par GrapheAlignement : une vidéo qui recouvre mal la référence est placée grâce aux autres
+     * angles. L'analyse est toujours faite en mémoire.
+     *
+     * @param fichierRef Chemin du fichier de référence (audio ou vidéo), placé à l'instant zéro.
+     * @param fichiersVideo Chemins des vidéos à analyser.
+     * @param premierNumero Numéro affiché pour la première vidéo de la liste.
+     * @param pool Pool partagé à utiliser (nul pour un pool propre à l'analyse).
+     * @return Les vidéos reliées à la référence, avec leur décalage et leur confiance.
+     * @throws runtime_error Si la référence ne peut pas être décodée.
+     */
+    vector<InfoVideo> analyserGlobal(const string &fichierRef, const vector<string> &fichiersVideo,
+                                     int premierNumero, PoolThreads *pool = nullptr) const;
+
+    /**
+     * @brief Analyse les entrées d'une génération : décalages, puis dérives si le suivi est actif.
+     *
+     * Sans audio externe, la première vidéo sert de référence et figure en tête du résultat avec un retard nul.
+     *
+     * @param fichierAudioRef Chemin de l'audio de référence (vide pour la première vidéo).
+     * @param fichiersVideo Chemins des vidéos à synchroniser.
+     * @param pool Pool partagé à utiliser (nul pour un pool propre à l'analyse).
+     * @return Les vidéos à assembler, avec leur décalage.
+     * @throws runtime_error S'il manque des vidéos ou si la référence ne peut pas être décodée.
+     */
+    vector<InfoVideo> analyserEntrees(const string &fichierAudioRef, const vector<string> &fichiersVideo,
+                                      PoolThreads *pool = nullptr) const;
+
+    /**
+     * @brief Estime la dérive d'horloge de chaque vidéo par EstimateurDerive.
+     *
+     * Le décalage de chaque vidéo est remplacé par celui du modèle affine, à l'instant 0 de la référence.
+     * Une vidéo dont la dérive ne peut être estimée garde son décalage constant.
+     *
+     * @param fichierRef Chemin du fichier de référence.
+     * @param listeVideos Vidéos déjà analysées, mises à jour en place.
+     * @param premierNumero Numéro affiché pour la première vidéo de la liste.
+     */
+    void estimerDerives(const string &fichierRef, vector<InfoVideo> &listeVideos, int premierNumero) const;
+
+    /**
+     * @brief Recrée les métriques au début d'une génération, si un rapport est demandé.
+     */
+    void demarrerMetriques() const;
+
+    /**
+     * @brief Écrit le rapport JSON et la trace demandés ; une erreur d'écriture est seulement signalée.
+     */
+    void ecrireMetriques() const;
+
+    /**
+     * @brief Calcule une dimension de tuile à l'échelle du profil d'encodage.
+     * @param dimension Dimension nominale (en pixels).
+     * @return La dimension mise à l'échelle, arrondie au nombre pair le plus proche.
+     */
+    int dimensionTuile(int dimension) const;
 
     /**
      * @brief Exécute la commande FFmpeg pour générer la vidéo finale.
      *
+     * Les décalages sont d'abord ramenés à un zéro commun par Chronologie, à partir des durées lues
+     * dans les conteneurs : chaque entrée est positionnée (-ss) et bornée (-t) à la lecture, de sorte
+     * qu'aucune image hors de la sortie n'est décodée. Les entrées qui démarrent après le zéro commun
+     * sont précédées d'images noires (et l'audio de référence d'un silence).
+     *
      * @param listeVideos Liste des vidéos à assembler.
      * @param fichierSortie Chemin du fichier de sortie.
      * @param fichierAudioRef Chemin du fichier audio de référence (optionnel).
@@ -108,26 +543,270 @@ class SynchroniseurMultiVideo {
     bool genererVideo(const vector<InfoVideo> &listeVideos, const string &fichierSortie,
                       const string &fichierAudioRef = "") const;
 
+    /**
+     * @brief Génère la vidéo finale dans le processus, sans ligne de commande ffmpeg.
+     *
+     * Les vidéos sont décodées en parallèle et mises à l'échelle directement dans leur tuile (RenduMosaique) ;
+     * l'audio de la première entrée est recopié sans réencodage. Le débit de chaque étape est affiché.
+     *
+     * @param listeVideos Liste des vidéos à assembler.
+     * @param placements Placement de chaque entrée (audio de référence éventuel, puis vidéos).
+     * @param duree Durée de la sortie (en secondes).
+     * @param fichierSortie Chemin du fichier de sortie.
+     * @param fichierAudioRef Chemin du fichier audio de référence (optionnel).
+     * @return true si succès.
+     * @throws runtime_error En cas d'erreur de décodage, d'encodage ou d'écriture.
+     */
+    bool genererVideoNative(const vector<InfoVideo> &listeVideos, const vector<Chronologie::Placement> &placements,
+                            double duree, const string &fichierSortie, const string &fichierAudioRef) const;
+
+    /**
+     * @brief Banc d'essai des moteurs de corrélation (bench/BancEssai.cpp), qui appelle calculerDecalage directement.
+     */
+    friend class BancEssai;
+
 public:
     /**
-     * @brief Destructeur de la classe SynchroniseurMultiVideo.
+     * @brief Mesure le décalage entre deux signaux audio déjà décodés.
+     *
+     * Les signaux doivent être mono, à la fréquence obtenirFrequenceAnalyse(). Méthode réentrante :
+     * plusieurs mesures peuvent s'exécuter en même temps sur une même instance, sans rien écrire à l'écran.
+     *
+     * @param ref Échantillons de l'audio de référence.
+     * @param cible Échantillons de l'audio à synchroniser.
+     * @param aPriori Décalage attendu, autour duquel la plage de recherche est centrée (en secondes).
+     * @return Le décalage de la cible, la corrélation normalisée des signaux ainsi alignés et la netteté du pic.
+     * @throws runtime_error Si un signal est vide ou si le moteur ne trouve aucun retard.
+     */
+    ResultatDecalage mesurerDecalage(span<const float> ref, span<const float> cible, double aPriori = 0.0) const;
+
+    /**
+     * @brief Mesure le décalage entre les pistes audio de deux fichiers.
+     *
+     * Les dureeAnalyse premières secondes sont décodées en mémoire (ou relues du cache s'il est configuré).
+     * Si l'analyse en flux est active, les fichiers sont lus par blocs et la confiance n'est pas mesurée (-1).
+     * Méthode réentrante, comme la précédente.
      *
-     * Supprime les fichiers temporaires créés lors de l'analyse audio.
+     * @param fichierRef Chemin du fichier de référence (audio ou vidéo).
+     * @param fichierCible Chemin du fichier à synchroniser (audio ou vidéo).
+     * @param aPriori Décalage attendu (en secondes, ignoré par l'analyse en flux).
+     * @return Le décalage de la cible et ses scores.
+     * @throws runtime_error Si un fichier ne peut pas être décodé ou si le moteur ne trouve aucun retard.
      */
-    ~SynchroniseurMultiVideo();
+    ResultatDecalage mesurerDecalage(const string &fichierRef, const string &fichierCible,
+                                     double aPriori = 0.0) const;
+
+    /**
+     * @brief Retourne la fréquence des signaux attendus par mesurerDecalage (en Hz).
+     */
+    int obtenirFrequenceAnalyse() const;
 
     /**
      * @brief Configure les paramètres d'analyse.
      * @param duree Durée de l'audio à analyser (en secondes).
      * @param plage Plage de recherche maximale (en secondes).
-     * @param pas Pas de précision (1 pour précision maximale).
+     * @param pas Pas de précision (1 pour précision maximale), utilisé seulement par MethodeCorrelation::Directe :
+     *            le moteur par défaut, FFT, l'ignore.
+     * @param methode Moteur de corrélation à utiliser (nullopt pour garder le moteur actuel, FFT par défaut).
+     */
+    void configurerAnalyse(double duree, double plage, int pas, optional<MethodeCorrelation> methode = nullopt);
+
+    /**
+     * @brief Configure le parallélisme de l'analyse.
+     * @param threads Nombre maximal de vidéos analysées simultanément (0 pour le nombre de cœurs disponibles).
+     */
+    void configurerParallelisme(unsigned int threads);
+
+    /**
+     * @brief Configure la recherche hiérarchique (MethodeCorrelation::Hierarchique).
+     * @param frequence Fréquence cible des signaux décimés (en Hz, typiquement 2000 à 4000).
+     * @param candidats Nombre de pics grossiers affinés à pleine résolution.
+     */
+    void configurerRechercheHierarchique(int frequence, int candidats);
+
+    /**
+     * @brief Configure la recherche progressive, arrêtée dès qu'un pic net est trouvé près du décalage a priori.
+     * @param actif Active la recherche progressive (sinon, toute la plage est parcourue).
+     * @param fenetre Demi-largeur de la première plage (en secondes), quadruplée à chaque élargissement.
+     * @param seuil Rapport pic sur lobes suffisant pour arrêter l'élargissement.
+     */
+    void configurerRechercheProgressive(bool actif, double fenetre = 2.0, double seuil = 12.0);
+
+    /**
+     * @brief Configure la recherche par empreintes (MethodeCorrelation::Empreinte).
+     * @param votes Nombre minimal de repères concordants pour accepter un retard.
+     */
+    void configurerEmpreintes(int votes);
+
+    /**
+     * @brief Active l'analyse en flux, à mémoire bornée, pour les enregistrements longs.
+     *
+     * L'audio n'est plus chargé en entier : il est décodé par morceaux dans des tampons circulaires
+     * et corrélé bloc par bloc. Chaque fenêtre analysée dure dureeAnalyse secondes.
+     *
+     * @param memoireMax Budget mémoire total de l'analyse (en octets, 0 pour revenir à l'analyse en mémoire).
+     * @param debuts Instants de début des fenêtres à analyser (en secondes dans la référence).
+     */
+    void configurerLectureFlux(size_t memoireMax, const vector<double> &debuts = {0.0});
+
+    /**
+     * @brief Active le cache disque des signaux d'analyse.
+     *
+     * Les signaux décodés y sont conservés d'une exécution à l'autre ; une nouvelle analyse d'un fichier
+     * inchangé (même chemin, taille, date, contenu et paramètres) ne décode plus rien.
+     * Le cache n'est pas utilisé par l'analyse en flux.
+     *
+     * @param dossier Dossier du cache (vide pour désactiver).
+     */
+    void configurerCache(const string &dossier);
+
+    /**
+     * @brief Active l'alignement global de tous les fichiers entre eux.
+     *
+     * Au lieu d'aligner chaque vidéo sur la seule référence, tous les décalages de paires sont mesurés
+     * puis résolus par moindres carrés pondérés par leur confiance. Le coût croît avec le carré
+     * du nombre de fichiers.
+     *
+     * @param actif true pour l'alignement global, false pour l'alignement sur la référence.
+     * @param confianceMin Confiance minimale d'une mesure de paire (0 à 1).
+     */
+    void configurerAlignementGlobal(bool actif, double confianceMin = 0.1);
+
+    /**
+     * @brief Choisit l'étendue de la vidéo générée.
+     *
+     * @param recouvrement true (par défaut) pour ne garder que la partie filmée par toutes les entrées,
+     *                     false pour couvrir toutes les entrées, les tuiles absentes restant noires.
+     */
+    void configurerChronologie(bool recouvrement);
+
+    /**
+     * @brief Active le suivi de la dérive d'horloge des vidéos sur toute leur durée.
+     *
+     * Des fenêtres courtes sont corrélées tout au long de chaque vidéo pour ajuster un décalage et une dérive
+     * (les caméras bon marché dérivent de plusieurs dizaines de millisecondes par heure). La dérive est
+     * compensée au rendu en lisant chaque vidéo à la cadence de son horloge.
+     *
+     * @param actif true pour activer le suivi.
+     * @param dureeFenetre Durée de chaque fenêtre corrélée (en secondes).
+     * @param intervalle Écart entre deux fenêtres (en secondes).
+     */
+    void configurerDerive(bool actif, double dureeFenetre = 5.0, double intervalle = 30.0);
+
+    /**
+     * @brief Choisit le moteur de génération de la vidéo.
+     *
+     * @param natif true (par défaut) pour le rendu dans le processus par RenduMosaique,
+     *              false pour la ligne de commande ffmpeg.
+     */
+    void configurerRenduNatif(bool natif);
+
+    /**
+     * @brief Active le rapport des métriques d'exécution.
+     *
+     * Chaque étape (décodage, cache, corrélation, dérive, chronologie, rendu...) est mesurée par fichier :
+     * temps écoulé, temps CPU, octets lus, échantillons corrélés, retards évalués et pic de mémoire.
+     * Le rapport est écrit à la fin de chaque génération.
+     *
+     * @param fichierJSON Chemin du rapport JSON (vide pour aucun).
+     * @param fichierChrome Chemin de la trace au format Chrome Trace (vide pour aucune).
+     */
+    void configurerMetriques(const string &fichierJSON, const string &fichierChrome = "");
+
+    /**
+     * @brief Découpe le rendu natif en segments encodés en parallèle puis assemblés sans réencodage.
+     *
+     * Les segments sont alignés sur la taille de GOP du profil d'encodage. Utile pour les rendus longs,
+     * lorsque l'encodeur seul n'occupe pas tous les cœurs.
+     *
+     * @param nombre Nombre de segments (0 pour un par cœur disponible, 1 pour désactiver).
+     */
+    void configurerSegments(int nombre);
+
+    /**
+     * @brief Choisit les réglages d'encodage de la vidéo générée.
+     *
+     * @param profil Profil d'encodage, par exemple ProfilEncodage::apercu() pour un rendu de contrôle rapide
+     *               ou ProfilEncodage::archive() pour le master.
+     */
+    void configurerEncodage(const ProfilEncodage &profil);
+
+    /**
+     * @brief Écrit les décalages et placements de chaque source dans une fiche annexe.
+     *
+     * La fiche (JSON, ou EDL CMX 3600 si l'extension est .edl) permet de reproduire la synchronisation
+     * en aval par simple recopie des flux, sans réencodage.
+     *
+     * @param fichier Chemin de la fiche (vide pour désactiver).
+     * @param seulement true pour n'écrire que la fiche, sans générer la vidéo.
+     */
+    void configurerFicheSynchro(const string &fichier, bool seulement = false);
+
+    /**
+     * @brief Configure le suivi en direct (suivreEnDirect).
+     *
+     * @param frequence Fréquence d'analyse (en Hz) : 8000 Hz donnent une précision bien inférieure à l'image.
+     * @param periode Intervalle entre deux publications (en secondes), qui borne leur latence.
+     * @param memoire Durée corrélée pour acquérir un décalage, et constante de temps de l'oubli (en secondes).
+     * @param plageSuivi Écart suivi autour du décalage acquis (en secondes) ; au-delà, le décalage est recherché
+     *                   à nouveau sur toute la plage de configurerAnalyse.
+     */
+    void configurerDirect(int frequence = 8000, double periode = 0.25, double memoire = 10.0, double plageSuivi = 1.0);
+
+    /**
+     * @brief Suit les décalages de sources en cours d'enregistrement, jusqu'à la fin de leurs flux.
+     *
+     * Les sources peuvent être des fichiers en cours d'écriture (dans un conteneur lisible pendant l'écriture :
+     * MPEG-TS, Matroska, MP4 fragmenté, WAV...), des tubes nommés ou des URL de flux (tcp://, udp://...).
+     * Le premier décalage de chaque source est publié une fois memoire + plageRechercheMax secondes reçues,
+     * les suivants toutes les periode secondes. Les positions sont comptées depuis le premier échantillon
+     * reçu de chaque source. Un fichier sans nouvelles données pendant 10 s est considéré terminé.
+     *
+     * @param fichierRef Source de référence.
+     * @param fichiersVideo Sources à synchroniser.
+     * @param rappel Reçoit l'indice de la source dans fichiersVideo et son décalage ; retourner false arrête le suivi.
+     * @throws runtime_error Si une source n'a pas pu être ouverte ou décodée.
+     */
+    void suivreEnDirect(const string &fichierRef, const vector<string> &fichiersVideo,
+                        const function<bool(size_t, const ResultatDecalage &)> &rappel) const;
+
+    /**
+     * @brief Configure le traitement par lots (genererLot).
+     *
+     * @param analyses Nombre maximal de travaux analysés en même temps, pendant l'encodage des précédents.
+     * @param encodages Nombre maximal de travaux encodés en même temps.
+     */
+    void configurerLot(size_t analyses = 2, size_t encodages = 1);
+
+    /**
+     * @brief Génère les vidéos d'un lot de travaux sur un seul pool de threads.
+     *
+     * Les analyses partagent le pool (nombreThreads), le cache des signaux et le rapport de métriques,
+     * écrit une seule fois à la fin du lot. L'analyse des travaux suivants se poursuit pendant l'encodage
+     * des précédents. Chaque travail reprend la configuration courante, avec son propre parallélisme
+     * d'analyse et sa propre fiche de synchronisation (la fiche de configurerFicheSynchro est ignorée).
+     *
+     * Un encodage n'est pas découpé en tâches du pool : il en occupe un thread pendant tout le rendu,
+     * et ses décodeurs et son encodeur ont leurs propres threads. Ceux-ci sont limités à nombreThreads
+     * divisé par le nombre d'encodages simultanés (configurerLot), pour ne pas surcharger la machine.
+     *
+     * @param travaux Travaux à exécuter.
+     * @return La réussite de chaque travail, dans l'ordre du lot.
+     */
+    vector<bool> genererLot(const vector<LotSynchronisation::Travail> &travaux) const;
+
+    /**
+     * @brief Génère les vidéos d'un lot décrit par un manifeste (voir LotSynchronisation::lireManifeste).
+     *
+     * @param manifeste Chemin du manifeste.
+     * @return La réussite de chaque travail, dans l'ordre du manifeste (vide si le manifeste est invalide).
      */
-    void configurerAnalyse(double duree, double plage, int pas);
+    vector<bool> genererLot(const string &manifeste) const;
 
     /**
      * @brief Génère une vidéo synchronisée à partir de plusieurs fichiers d'entrée.
      *
-     * Orchestre le processus complet : extraction audio, calcul des décalages,
+     * Orchestre le processus complet : décodage audio, calcul des décalages,
      * et génération de la vidéo finale avec FFmpeg.
      *
      * @param fichiersEntree Liste des chemins des fichiers vidéo à synchroniser.
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class TamponCirculaire
+ * @brief Tampon circulaire d'échantillons repérés par leur position absolue dans le flux.
+ *
+ * La capacité est fixée à la construction : la mémoire occupée ne dépend pas de la longueur du flux.
+ * Les échantillons sont écrits directement dans la zone libre (sans copie intermédiaire),
+ * puis libérés une fois consommés.
+ */
+class TamponCirculaire {
+    /**
+     * @brief Stockage circulaire.
+     */
+    vector<float> donnees;
+
+    /**
+     * @brief Position absolue du plus ancien échantillon disponible.
+     */
+    int64_t debut = 0;
+
+    /**
+     * @brief Position absolue suivant le plus récent échantillon disponible.
+     */
+    int64_t fin = 0;
+
+public:
+    /**
+     * @brief Alloue le tampon.
+     * @param capacite Nombre maximal d'échantillons conservés.
+     */
+    explicit TamponCirculaire(size_t capacite);
+
+    /**
+     * @brief Vide le tampon et place la prochaine écriture à une position absolue donnée.
+     */
+    void reinitialiser(int64_t position);
+
+    /**
+     * @brief Position absolue du plus ancien échantillon disponible.
+     */
+    int64_t obtenirDebut() const;
+
+    /**
+     * @brief Position absolue suivant le plus récent échantillon disponible.
+     */
+    int64_t obtenirFin() const;
+
+    /**
+     * @brief Zone contiguë où écrire les prochains échantillons (éventuellement plus courte que l'espace libre).
+     */
+    span<float> zoneEcriture();
+
+    /**
+     * @brief Valide l'écriture de n échantillons dans la zone retournée par zoneEcriture().
+     */
+    void valider(size_t n);
+
+    /**
+     * @brief Libère les échantillons antérieurs à une position absolue.
+     */
+    void liberer(int64_t position);
+
+    /**
+     * @brief Copie les échantillons à partir d'une position absolue.
+     *
+     * Les positions hors de [obtenirDebut(), obtenirFin()[ sont complétées par des zéros
+     * (avant le début ou après la fin du flux).
+     */
+    void copier(int64_t position, span<float> destination) const;
+};
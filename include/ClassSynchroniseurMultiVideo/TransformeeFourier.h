@@ -0,0 +1,61 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class TransformeeFourier
+ * @brief Plan de transformée de Fourier rapide (FFT radix-2) réutilisable.
+ *
+ * Le plan précalcule les facteurs de rotation et la permutation par inversion de bits
+ * pour une taille donnée (puissance de deux). Un même plan peut ensuite être appliqué
+ * à autant de tampons que nécessaire sans nouvelle allocation.
+ */
+class TransformeeFourier {
+    /**
+     * @brief Taille de la transformée (puissance de deux).
+     */
+    size_t taille;
+
+    /**
+     * @brief Facteurs de rotation exp(-2iπk/taille) pour k dans [0, taille/2[.
+     */
+    vector<complex<double> > facteursRotation;
+
+    /**
+     * @brief Table de permutation par inversion de bits.
+     */
+    vector<uint32_t> inversionBits;
+
+public:
+    /**
+     * @brief Construit un plan pour une taille au moins égale à celle demandée.
+     * @param tailleMinimale Nombre minimal de points de la transformée.
+     * @throws invalid_argument Si la taille est nulle ou trop grande.
+     */
+    explicit TransformeeFourier(size_t tailleMinimale);
+
+    /**
+     * @brief Retourne la taille effective (puissance de deux) de la transformée.
+     */
+    size_t obtenirTaille() const;
+
+    /**
+     * @brief Applique la transformée sur place.
+     *
+     * @param donnees Tampon de exactement obtenirTaille() points.
+     * @param inverse true pour la transformée inverse (normalisée par 1/taille).
+     * @throws invalid_argument Si la taille du tampon ne correspond pas au plan.
+     */
+    void transformer(span<complex<double> > donnees, bool inverse = false) const;
+
+    /**
+     * @brief Retourne la plus petite puissance de deux supérieure ou égale à n.
+     */
+    static size_t puissanceDeuxSuperieure(size_t n);
+};
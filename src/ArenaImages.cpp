@@ -0,0 +1,100 @@
+/**
+ * @file ArenaImages.cpp
+ * @brief Implémentation de l'arène d'images de sortie.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/ArenaImages.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+extern "C" {
+#include <libavutil/buffer.h>
+#include <libavutil/frame.h>
+}
+
+using namespace std;
+
+namespace {
+    size_t arrondir(size_t taille, size_t alignement) {
+        return (taille + alignement - 1) / alignement * alignement;
+    }
+
+    /**
+     * @brief Les images ne possèdent pas leur mémoire : le bloc est libéré par l'arène.
+     */
+    void liberationNulle(void *, uint8_t *) {
+    }
+}
+
+ArenaImages::ArenaImages(int largeur, int hauteur, size_t nombre) {
+    const size_t pasLuminance = arrondir(largeur, ALIGNEMENT);
+    const size_t pasChrominance = arrondir(largeur / 2, ALIGNEMENT);
+
+    const size_t tailleLuminance = pasLuminance * hauteur;
+    const size_t tailleChrominance = pasChrominance * (hauteur / 2);
+    const size_t tailleImage = arrondir(tailleLuminance + 2 * tailleChrominance, ALIGNEMENT);
+
+    bloc.reset(static_cast<uint8_t *>(::operator new[](tailleImage * nombre, align_val_t(ALIGNEMENT))));
+
+    images.reserve(nombre);
+    confiees.assign(nombre, false);
+
+    try {
+        for (size_t i = 0; i < nombre; ++i) {
+            uint8_t *debut = bloc.get() + i * tailleImage;
+
+            // Noir en YUV à plage limitée.
+            memset(debut, 16, tailleLuminance);
+            memset(debut + tailleLuminance, 128, 2 * tailleChrominance);
+
+            AVFrame *image = av_frame_alloc();
+            if (!image) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+            images.push_back(image);
+
+            // L'unique référence est détenue par l'image : elle reste inscriptible tant que l'encodeur
+            // n'en a pas pris une seconde.
+            image->buf[0] = av_buffer_create(debut, tailleImage, liberationNulle, nullptr, 0);
+            if (!image->buf[0]) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+
+            image->format = AV_PIX_FMT_YUV420P;
+            image->width = largeur;
+            image->height = hauteur;
+
+            image->data[0] = debut;
+            image->data[1] = debut + tailleLuminance;
+            image->data[2] = debut + tailleLuminance + tailleChrominance;
+
+            image->linesize[0] = static_cast<int>(pasLuminance);
+            image->linesize[1] = static_cast<int>(pasChrominance);
+            image->linesize[2] = static_cast<int>(pasChrominance);
+        }
+    } catch (...) {
+        for (AVFrame *&image: images) av_frame_free(&image);
+        throw;
+    }
+}
+
+ArenaImages::~ArenaImages() {
+    for (AVFrame *&image: images) av_frame_free(&image);
+}
+
+AVFrame *ArenaImages::acquerir() {
+    for (size_t essai = 0; essai < images.size(); ++essai) {
+        const size_t i = (prochaine + essai) % images.size();
+
+        if (confiees[i] || !av_frame_is_writable(images[i])) continue;
+
+        confiees[i] = true;
+        prochaine = (i + 1) % images.size();
+        return images[i];
+    }
+
+    throw runtime_error("Arène d'images épuisée : l'encodeur conserve trop d'images.");
+}
+
+void ArenaImages::rendre(AVFrame *image) {
+    const auto position = find(images.begin(), images.end(), image);
+    if (position != images.end()) confiees[position - images.begin()] = false;
+}
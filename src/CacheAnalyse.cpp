@@ -0,0 +1,181 @@
+/**
+ * @file CacheAnalyse.cpp
+ * @brief Implémentation du cache disque des signaux d'analyse.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/CacheAnalyse.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Signature des fichiers du cache.
+     */
+    constexpr char SIGNATURE[8] = {'S', 'M', 'V', 'C', 'A', 'C', 'H', '1'};
+
+    /**
+     * @brief Taille réservée à l'en-tête : les échantillons restent alignés sur 64 octets.
+     */
+    constexpr size_t TAILLE_EN_TETE = 64;
+
+    /**
+     * @brief Taille de chaque zone lue pour l'empreinte du contenu.
+     */
+    constexpr size_t TAILLE_ECHANTILLON_EMPREINTE = 1 << 20;
+
+    /**
+     * @struct EnTete
+     * @brief En-tête d'une entrée du cache.
+     */
+    struct EnTete {
+        char signature[8]; /**< Signature SIGNATURE. */
+        int32_t frequence; /**< Fréquence d'échantillonnage du signal (en Hz). */
+        int32_t reserve; /**< Réservé (zéro). */
+        uint64_t nombre; /**< Nombre d'échantillons float qui suivent l'en-tête. */
+    };
+
+    static_assert(sizeof(EnTete) <= TAILLE_EN_TETE);
+
+    /**
+     * @brief Hachage FNV-1a 64 bits, incrémental.
+     */
+    uint64_t hacher(const void *donnees, size_t taille, uint64_t etat = 0xcbf29ce484222325ull) {
+        const auto *octets = static_cast<const unsigned char *>(donnees);
+        for (size_t i = 0; i < taille; ++i) {
+            etat ^= octets[i];
+            etat *= 0x100000001b3ull;
+        }
+        return etat;
+    }
+}
+
+CacheAnalyse::CacheAnalyse(const filesystem::path &dossier) : dossier(dossier) {
+    filesystem::create_directories(dossier);
+}
+
+uint64_t CacheAnalyse::empreinteContenu(const filesystem::path &fichier, uintmax_t taille) {
+    ifstream flux(fichier, ios::binary);
+    if (!flux.is_open()) return 0;
+
+    vector<char> tampon(TAILLE_ECHANTILLON_EMPREINTE);
+    uint64_t etat = hacher(&taille, sizeof(taille));
+
+    // Trois zones suffisent à distinguer deux prises tout en évitant de relire des gigaoctets.
+    const array<uintmax_t, 3> positions = {
+        0,
+        taille / 2,
+        taille > TAILLE_ECHANTILLON_EMPREINTE ? taille - TAILLE_ECHANTILLON_EMPREINTE : 0
+    };
+
+    for (const uintmax_t position: positions) {
+        flux.clear();
+        flux.seekg(static_cast<streamoff>(position));
+        flux.read(tampon.data(), static_cast<streamsize>(tampon.size()));
+        etat = hacher(tampon.data(), static_cast<size_t>(flux.gcount()), etat);
+    }
+
+    return etat;
+}
+
+string CacheAnalyse::calculerCle(const string &fichier, int frequence, double duree) {
+    error_code erreur;
+    const filesystem::path chemin = filesystem::canonical(fichier, erreur);
+    if (erreur || !filesystem::is_regular_file(chemin, erreur)) return "";
+
+    const uintmax_t taille = filesystem::file_size(chemin, erreur);
+    if (erreur) return "";
+
+    const auto modification = filesystem::last_write_time(chemin, erreur).time_since_epoch().count();
+    if (erreur) return "";
+
+    const string texteChemin = chemin.string();
+
+    uint64_t etat = hacher(texteChemin.data(), texteChemin.size());
+    etat = hacher(&taille, sizeof(taille), etat);
+    etat = hacher(&modification, sizeof(modification), etat);
+    etat = hacher(&frequence, sizeof(frequence), etat);
+    etat = hacher(&duree, sizeof(duree), etat);
+
+    const uint64_t contenu = empreinteContenu(chemin, taille);
+    etat = hacher(&contenu, sizeof(contenu), etat);
+
+    stringstream cle;
+    cle << hex << setw(16) << setfill('0') << etat;
+    return cle.str();
+}
+
+optional<SignalAudio> CacheAnalyse::charger(const string &cle, int frequence) const {
+    if (cle.empty()) return nullopt;
+
+    const filesystem::path chemin = dossier / (cle + ".pcm");
+
+    ifstream flux(chemin, ios::binary);
+    if (!flux.is_open()) return nullopt;
+
+    EnTete enTete{};
+    flux.read(reinterpret_cast<char *>(&enTete), sizeof(enTete));
+    if (!flux) return nullopt;
+
+    // Entrée d'un autre format, d'une autre fréquence ou tronquée : ignorée (elle sera réécrite).
+    error_code erreur;
+    const uintmax_t taille = filesystem::file_size(chemin, erreur);
+
+    if (memcmp(enTete.signature, SIGNATURE, sizeof(SIGNATURE)) != 0 || enTete.frequence != frequence ||
+        erreur || taille != TAILLE_EN_TETE + enTete.nombre * sizeof(float)) {
+        return nullopt;
+    }
+
+    try {
+        return SignalAudio::projeter(chemin.string(), TAILLE_EN_TETE, enTete.nombre);
+    } catch (const exception &) {
+        return nullopt;
+    }
+}
+
+void CacheAnalyse::enregistrer(const string &cle, int frequence, span<const float> echantillons) const {
+    if (cle.empty()) return;
+
+    const filesystem::path chemin = dossier / (cle + ".pcm");
+
+    // Nom temporaire propre au thread : deux tâches sur le même fichier ne se marchent pas dessus.
+    stringstream suffixe;
+    suffixe << ".tmp" << this_thread::get_id() << "_" << chrono::steady_clock::now().time_since_epoch().count();
+    const filesystem::path temporaire = dossier / (cle + suffixe.str());
+
+    {
+        ofstream flux(temporaire, ios::binary | ios::trunc);
+        if (!flux.is_open()) return;
+
+        EnTete enTete{};
+        copy_n(SIGNATURE, sizeof(SIGNATURE), enTete.signature);
+        enTete.frequence = frequence;
+        enTete.nombre = echantillons.size();
+
+        array<char, TAILLE_EN_TETE> blocEnTete{};
+        memcpy(blocEnTete.data(), &enTete, sizeof(enTete));
+
+        flux.write(blocEnTete.data(), blocEnTete.size());
+        flux.write(reinterpret_cast<const char *>(echantillons.data()),
+                   static_cast<streamsize>(echantillons.size_bytes()));
+
+        if (!flux) {
+            flux.close();
+            error_code erreur;
+            filesystem::remove(temporaire, erreur);
+            return;
+        }
+    }
+
+    error_code erreur;
+    filesystem::rename(temporaire, chemin, erreur);
+    if (erreur) filesystem::remove(temporaire, erreur);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Chronologie.cpp
+ * @brief Implémentation du placement des sources sur la chronologie de sortie.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/Chronologie.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    constexpr double INFINI = numeric_limits<double>::infinity();
+}
+
+Chronologie::Chronologie(bool recouvrementSeul) : recouvrementSeul(recouvrementSeul) {
+}
+
+void Chronologie::ajouterSource(double retard, double duree) {
+    sources.push_back({retard, duree > 0.0 ? duree : INFINI});
+}
+
+void Chronologie::calculerBornes(double &debut, double &fin) const {
+    debut = recouvrementSeul ? -INFINI : INFINI;
+    fin = recouvrementSeul ? INFINI : -INFINI;
+
+    for (const Source &source: sources) {
+        // Intervalle couvert par la source, en temps de référence.
+        const double debutSource = -source.retard;
+        const double finSource = source.duree - source.retard;
+
+        debut = recouvrementSeul ? max(debut, debutSource) : min(debut, debutSource);
+        fin = recouvrementSeul ? min(fin, finSource) : max(fin, finSource);
+    }
+
+    if (sources.empty()) debut = fin = 0.0;
+}
+
+vector<Chronologie::Placement> Chronologie::placer() const {
+    double debut, fin;
+    calculerBornes(debut, fin);
+
+    if (fin <= debut) throw runtime_error("Les vidéos n'ont aucune partie commune.");
+
+    vector<Placement> placements;
+    placements.reserve(sources.size());
+
+    for (const Source &source: sources) {
+        // Position de la source à l'instant 0 de la sortie ; négative pour une source qui démarre plus tard.
+        const double position = debut + source.retard;
+
+        const double debutLecture = max(0.0, position);
+        const double delai = max(0.0, -position);
+        const double duree = min(source.duree - debutLecture, fin - debut - delai);
+
+        placements.push_back({debutLecture, delai, duree});
+    }
+
+    return placements;
+}
+
+double Chronologie::obtenirDuree() const {
+    double debut, fin;
+    calculerBornes(debut, fin);
+
+    return max(0.0, fin - debut);
+}
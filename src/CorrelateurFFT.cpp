@@ -0,0 +1,76 @@
+/**
+ * @file CorrelateurFFT.cpp
+ * @brief Implémentation de la corrélation croisée par FFT.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/CorrelateurFFT.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void CorrelateurFFT::correler(span<const float> ref, span<const float> cible, ptrdiff_t retardMin,
+                              ptrdiff_t retardMax, vector<double> &sortie) {
+    sortie.assign(retardMax >= retardMin ? retardMax - retardMin + 1 : 0, 0.0);
+
+    if (sortie.empty() || ref.empty() || cible.empty()) return;
+
+    Metriques::compterCorrelation(static_cast<int64_t>(ref.size()), static_cast<int64_t>(sortie.size()));
+
+    const auto tailleRef = static_cast<ptrdiff_t>(ref.size());
+
+    // Seule la portion de la cible atteignable par les retards demandés est utile :
+    // j = i + k avec i dans [0, tailleRef[ et k dans [retardMin, retardMax].
+    const ptrdiff_t debutCible = max<ptrdiff_t>(retardMin, 0);
+    const ptrdiff_t finCible = min<ptrdiff_t>(static_cast<ptrdiff_t>(cible.size()), tailleRef + retardMax);
+
+    if (finCible <= debutCible) return;
+
+    const ptrdiff_t tailleCible = finCible - debutCible;
+
+    // Taille suffisante pour que la corrélation circulaire n'introduise aucun repliement.
+    const size_t tailleNecessaire = TransformeeFourier::puissanceDeuxSuperieure(tailleRef + tailleCible - 1);
+
+    if (!plan || plan->obtenirTaille() != tailleNecessaire) {
+        plan = make_unique<TransformeeFourier>(tailleNecessaire);
+    }
+
+    const size_t n = plan->obtenirTaille();
+    tampon.assign(n, complex<double>(0.0, 0.0));
+
+    // Empaquetage : partie réelle = référence, partie imaginaire = cible.
+    for (ptrdiff_t i = 0; i < tailleRef; ++i) tampon[i].real(ref[i]);
+    for (ptrdiff_t i = 0; i < tailleCible; ++i) tampon[i].imag(cible[debutCible + i]);
+
+    plan->transformer(tampon);
+
+    // Séparation des deux spectres (symétrie hermitienne) puis produit conj(R) * C, sur place.
+    // Le produit est lui-même hermitien : P[n - k] = conj(P[k]).
+    for (size_t k = 0; k <= n / 2; ++k) {
+        const size_t kMiroir = (n - k) & (n - 1);
+
+        const complex<double> z = tampon[k];
+        const complex<double> zMiroir = conj(tampon[kMiroir]);
+
+        const complex<double> spectreRef = (z + zMiroir) * 0.5;
+        const complex<double> spectreCible = (z - zMiroir) * complex<double>(0.0, -0.5);
+
+        const complex<double> produit = conj(spectreRef) * spectreCible;
+
+        tampon[k] = produit;
+        tampon[kMiroir] = conj(produit);
+    }
+
+    plan->transformer(tampon, true);
+
+    // Relecture des retards demandés ; les indices négatifs sont repliés en fin de tampon.
+    for (ptrdiff_t k = retardMin; k <= retardMax; ++k) {
+        const ptrdiff_t retardLocal = k - debutCible;
+
+        if (retardLocal <= -tailleRef || retardLocal >= tailleCible) continue;
+
+        const size_t indice = retardLocal >= 0 ? retardLocal : n + retardLocal;
+        sortie[k - retardMin] = tampon[indice].real();
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file CorrelateurIncremental.cpp
+ * @brief Implémentation de la corrélation croisée accumulée par blocs.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/CorrelateurIncremental.h"
+
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <stdexcept>
+
+using namespace std;
+
+CorrelateurIncremental::CorrelateurIncremental(ptrdiff_t retardMin, ptrdiff_t retardMax)
+    : retardMin(retardMin), retardMax(retardMax), correlation(retardMax - retardMin + 1, 0.0) {
+}
+
+void CorrelateurIncremental::accumuler(span<const float> blocRef, span<const float> segmentCible) {
+    if (segmentCible.size() != blocRef.size() + (retardMax - retardMin)) {
+        throw invalid_argument("Segment de cible incompatible avec le bloc de référence.");
+    }
+
+    // Dans le segment, le retard k correspond au décalage local k - retardMin.
+    correlateur.correler(blocRef, segmentCible, 0, retardMax - retardMin, contribution);
+
+    for (size_t i = 0; i < correlation.size(); ++i) correlation[i] += contribution[i];
+}
+
+void CorrelateurIncremental::accumulerCible(span<const float> blocCible, span<const float> segmentRef) {
+    if (segmentRef.size() != blocCible.size() + (retardMax - retardMin)) {
+        throw invalid_argument("Segment de référence incompatible avec le bloc de cible.");
+    }
+
+    // Rôles inversés : le décalage local d de la référence correspond au retard retardMax - d.
+    correlateur.correler(blocCible, segmentRef, 0, retardMax - retardMin, contribution);
+
+    const size_t dernier = correlation.size() - 1;
+    for (size_t i = 0; i < correlation.size(); ++i) correlation[i] += contribution[dernier - i];
+}
+
+void CorrelateurIncremental::attenuer(double facteur) {
+    for (double &valeur: correlation) valeur *= facteur;
+}
+
+void CorrelateurIncremental::reinitialiser() {
+    fill(correlation.begin(), correlation.end(), 0.0);
+}
+
+const vector<double> &CorrelateurIncremental::obtenirCorrelation() const {
+    return correlation;
+}
+
+size_t CorrelateurIncremental::estimerMemoire(size_t tailleBloc, ptrdiff_t retardMin, ptrdiff_t retardMax) {
+    const size_t nbRetards = retardMax - retardMin + 1;
+    const size_t tailleSegment = tailleBloc + nbRetards - 1;
+    const size_t tailleFFT = TransformeeFourier::puissanceDeuxSuperieure(tailleBloc + tailleSegment - 1);
+
+    // Tampon FFT complexe + table de rotation et permutation du plan + corrélation et contribution.
+    return tailleFFT * sizeof(complex<double>)
+           + tailleFFT / 2 * sizeof(complex<double>) + tailleFFT * sizeof(uint32_t)
+           + 2 * nbRetards * sizeof(double);
+}
@@ -0,0 +1,69 @@
+/**
+ * @file Decimateur.cpp
+ * @brief Implémentation du filtre de décimation utilisé par la recherche multi-résolution.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/Decimateur.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+using namespace std;
+
+Decimateur::Decimateur(size_t facteur) : facteur(max<size_t>(facteur, 1)) {
+    if (this->facteur == 1) {
+        coefficients = {1.0f};
+        return;
+    }
+
+    // Quatre lobes de chaque côté : bon compromis entre réjection et coût.
+    const size_t demiLongueur = 4 * this->facteur;
+    const size_t longueur = 2 * demiLongueur + 1;
+
+    // Coupure à 90 % de la nouvelle fréquence de Nyquist (en cycles par échantillon).
+    const double coupure = 0.45 / static_cast<double>(this->facteur);
+
+    coefficients.resize(longueur);
+    double somme = 0.0;
+
+    for (size_t t = 0; t < longueur; ++t) {
+        const double x = static_cast<double>(t) - static_cast<double>(demiLongueur);
+        const double sinc = x == 0.0 ? 2.0 * coupure : sin(2.0 * numbers::pi * coupure * x) / (numbers::pi * x);
+        const double phase = 2.0 * numbers::pi * static_cast<double>(t) / static_cast<double>(longueur - 1);
+        const double fenetre = 0.42 - 0.5 * cos(phase) + 0.08 * cos(2.0 * phase);
+
+        coefficients[t] = static_cast<float>(sinc * fenetre);
+        somme += sinc * fenetre;
+    }
+
+    // Gain unitaire en continu.
+    for (auto &c: coefficients) c = static_cast<float>(c / somme);
+}
+
+size_t Decimateur::obtenirFacteur() const {
+    return facteur;
+}
+
+void Decimateur::decimer(span<const float> entree, vector<float> &sortie) const {
+    const size_t nbSortie = (entree.size() + facteur - 1) / facteur;
+    sortie.resize(nbSortie);
+
+    const auto taille = static_cast<ptrdiff_t>(entree.size());
+    const auto demiLongueur = static_cast<ptrdiff_t>(coefficients.size() / 2);
+
+    for (size_t m = 0; m < nbSortie; ++m) {
+        const ptrdiff_t centre = static_cast<ptrdiff_t>(m * facteur);
+
+        // Bornes du filtre restreintes au signal (bords complétés par des zéros).
+        const ptrdiff_t debut = max<ptrdiff_t>(0, centre - demiLongueur);
+        const ptrdiff_t fin = min<ptrdiff_t>(taille, centre + demiLongueur + 1);
+
+        double accumulateur = 0.0;
+        for (ptrdiff_t i = debut; i < fin; ++i) {
+            accumulateur += coefficients[i - centre + demiLongueur] * entree[i];
+        }
+
+        sortie[m] = static_cast<float>(accumulateur);
+    }
+}
@@ -0,0 +1,286 @@
+/**
+ * @file DecodeurAudio.cpp
+ * @brief Implémentation du décodage audio en mémoire via libavformat, libavcodec et libswresample.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurAudio.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/channel_layout.h>
+#include <libavutil/dict.h>
+#include <libavutil/error.h>
+#include <libswresample/swresample.h>
+}
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Construit un message d'erreur lisible à partir d'un code d'erreur FFmpeg.
+     */
+    string messageErreur(const string &contexte, int code) {
+        char description[256];
+        av_strerror(code, description, sizeof(description));
+        return contexte + " (" + description + ")";
+    }
+
+    /**
+     * @brief Rappel d'interruption de FFmpeg : vrai dès que l'arrêt est demandé.
+     */
+    int verifierArret(void *arret) {
+        return static_cast<const atomic<bool> *>(arret)->load() ? 1 : 0;
+    }
+}
+
+DecodeurAudio::DecodeurAudio(const string &fichier, int frequence, bool direct, const atomic<bool> *arret)
+    : frequence(frequence), direct(direct) {
+    AVDictionary *options = nullptr;
+
+    try {
+        format = avformat_alloc_context();
+        if (!format) throw runtime_error("Allocation du démultiplexeur impossible.");
+
+        if (arret) format->interrupt_callback = {verifierArret, const_cast<atomic<bool> *>(arret)};
+
+        if (direct) {
+            // Un fichier en cours d'écriture est relu à sa fin jusqu'à DELAI_INACTIVITE sans nouvelles données.
+            av_dict_set(&options, "follow", "1", 0);
+            av_dict_set_int(&options, "rw_timeout", static_cast<int64_t>(DELAI_INACTIVITE * 1e6), 0);
+            // Analyse initiale courte et sans mise en tampon : la latence compte plus que la précision de la sonde.
+            av_dict_set(&options, "fflags", "nobuffer", 0);
+            av_dict_set(&options, "analyzeduration", "500000", 0);
+        }
+
+        int code = avformat_open_input(&format, fichier.c_str(), nullptr, &options);
+        av_dict_free(&options);
+        if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir : " + fichier, code));
+
+        code = avformat_find_stream_info(format, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Flux illisibles : " + fichier, code));
+
+        const AVCodec *codec = nullptr;
+        indexFlux = av_find_best_stream(format, AVMEDIA_TYPE_AUDIO, -1, -1, &codec, 0);
+        if (indexFlux < 0 || !codec) throw runtime_error("Aucune piste audio dans : " + fichier);
+
+        // Seul le flux audio est démultiplexé : les paquets vidéo ne sont même pas lus.
+        for (unsigned int i = 0; i < format->nb_streams; ++i) {
+            if (static_cast<int>(i) != indexFlux) format->streams[i]->discard = AVDISCARD_ALL;
+        }
+
+        decodeur = avcodec_alloc_context3(codec);
+        if (!decodeur) throw runtime_error("Allocation du décodeur impossible.");
+
+        code = avcodec_parameters_to_context(decodeur, format->streams[indexFlux]->codecpar);
+        if (code < 0) throw runtime_error(messageErreur("Paramètres audio invalides : " + fichier, code));
+
+        code = avcodec_open2(decodeur, codec, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Ouverture du décodeur impossible : " + fichier, code));
+
+        // Certains conteneurs ne précisent que le nombre de canaux : on en déduit la disposition standard.
+        AVChannelLayout dispositionEntree;
+        if (decodeur->ch_layout.order == AV_CHANNEL_ORDER_UNSPEC) {
+            av_channel_layout_default(&dispositionEntree, decodeur->ch_layout.nb_channels);
+        } else {
+            av_channel_layout_copy(&dispositionEntree, &decodeur->ch_layout);
+        }
+
+        const AVChannelLayout dispositionMono = AV_CHANNEL_LAYOUT_MONO;
+
+        code = swr_alloc_set_opts2(&reechantillonneur,
+                                   &dispositionMono, AV_SAMPLE_FMT_FLT, frequence,
+                                   &dispositionEntree, decodeur->sample_fmt, decodeur->sample_rate,
+                                   0, nullptr);
+        av_channel_layout_uninit(&dispositionEntree);
+
+        if (code < 0 || swr_init(reechantillonneur) < 0) {
+            throw runtime_error(messageErreur("Initialisation du rééchantillonnage impossible : " + fichier, code));
+        }
+
+        paquet = av_packet_alloc();
+        trame = av_frame_alloc();
+        if (!paquet || !trame) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+    } catch (...) {
+        av_dict_free(&options);
+        liberer();
+        throw;
+    }
+}
+
+DecodeurAudio::~DecodeurAudio() {
+    liberer();
+}
+
+void DecodeurAudio::liberer() {
+    av_frame_free(&trame);
+    av_packet_free(&paquet);
+    swr_free(&reechantillonneur);
+    avcodec_free_context(&decodeur);
+    avformat_close_input(&format);
+}
+
+size_t DecodeurAudio::convertir(span<float> destination, const uint8_t *const *entree, int nbEntree) {
+    // Borne supérieure du nombre d'échantillons produits par cette conversion.
+    const int nbSortieMax = swr_get_out_samples(reechantillonneur, nbEntree);
+    if (nbSortieMax < 0) throw runtime_error("Erreur de rééchantillonnage.");
+
+    // Cas nominal : la place suffit, la conversion écrit directement chez l'appelant.
+    if (static_cast<size_t>(nbSortieMax) <= destination.size()) {
+        auto *sortie = reinterpret_cast<uint8_t *>(destination.data());
+        const int nb = swr_convert(reechantillonneur, &sortie, nbSortieMax, entree, nbEntree);
+        if (nb < 0) throw runtime_error("Erreur de rééchantillonnage.");
+        return nb;
+    }
+
+    // Sinon le surplus est conservé pour le prochain appel à lire().
+    reliquat.resize(nbSortieMax);
+    positionReliquat = 0;
+
+    auto *sortie = reinterpret_cast<uint8_t *>(reliquat.data());
+    const int nb = swr_convert(reechantillonneur, &sortie, nbSortieMax, entree, nbEntree);
+    if (nb < 0) throw runtime_error("Erreur de rééchantillonnage.");
+    reliquat.resize(nb);
+
+    const size_t copie = min(destination.size(), reliquat.size());
+    copy_n(reliquat.begin(), copie, destination.begin());
+    positionReliquat = copie;
+
+    return copie;
+}
+
+size_t DecodeurAudio::lire(span<float> destination) {
+    size_t ecrits = 0;
+
+    while (ecrits < destination.size()) {
+        // Échantillons restant d'une conversion précédente.
+        if (positionReliquat < reliquat.size()) {
+            const size_t copie = min(destination.size() - ecrits, reliquat.size() - positionReliquat);
+            copy_n(reliquat.begin() + positionReliquat, copie, destination.begin() + ecrits);
+            positionReliquat += copie;
+            ecrits += copie;
+            continue;
+        }
+
+        if (termine) break;
+
+        // Récupère d'abord les trames déjà décodées.
+        int code = avcodec_receive_frame(decodeur, trame);
+
+        if (code >= 0) {
+            // Après un déplacement, calcule l'écart entre la première trame et la position demandée.
+            if (alignementEnAttente) {
+                const AVStream *flux = format->streams[indexFlux];
+                const int64_t debutFlux = flux->start_time != AV_NOPTS_VALUE ? flux->start_time : 0;
+
+                if (trame->best_effort_timestamp != AV_NOPTS_VALUE) {
+                    const double instantTrame = (trame->best_effort_timestamp - debutFlux) * av_q2d(flux->time_base);
+                    const double ecart = (positionDemandee - instantTrame) * frequence;
+                    echantillonsASauter = ecart > 0.0 ? static_cast<size_t>(llround(ecart)) : 0;
+                }
+
+                alignementEnAttente = false;
+            }
+
+            if (echantillonsASauter > 0) {
+                // Conversion dans le reliquat, dont le début est écarté.
+                convertir({}, trame->extended_data, trame->nb_samples);
+                positionReliquat = min(echantillonsASauter, reliquat.size());
+                echantillonsASauter -= positionReliquat;
+            } else {
+                ecrits += convertir(destination.subspan(ecrits), trame->extended_data, trame->nb_samples);
+            }
+
+            av_frame_unref(trame);
+            continue;
+        }
+
+        if (code == AVERROR_EOF) {
+            // Vide les derniers échantillons retenus par le filtre de rééchantillonnage.
+            ecrits += convertir(destination.subspan(ecrits), nullptr, 0);
+            termine = true;
+            continue;
+        }
+
+        if (code != AVERROR(EAGAIN)) throw runtime_error(messageErreur("Erreur de décodage audio", code));
+
+        // Le décodeur attend des données : lit le prochain paquet audio.
+        code = av_read_frame(format, paquet);
+
+        // En direct, la fermeture, l'inactivité prolongée ou l'arrêt demandé terminent le flux.
+        const bool coupure = direct && (code == AVERROR(EIO) || code == AVERROR(ETIMEDOUT) || code == AVERROR_EXIT);
+
+        if (code == AVERROR_EOF || coupure) {
+            avcodec_send_packet(decodeur, nullptr);
+            continue;
+        }
+
+        if (code < 0) throw runtime_error(messageErreur("Erreur de lecture du conteneur", code));
+
+        if (paquet->stream_index == indexFlux) {
+            Metriques::compterOctets(paquet->size);
+
+            code = avcodec_send_packet(decodeur, paquet);
+            // Un paquet corrompu est ignoré, comme le ferait la ligne de commande ffmpeg.
+            if (code < 0 && code != AVERROR_INVALIDDATA && code != AVERROR(EAGAIN)) {
+                av_packet_unref(paquet);
+                throw runtime_error(messageErreur("Erreur de décodage audio", code));
+            }
+        }
+
+        av_packet_unref(paquet);
+    }
+
+    return ecrits;
+}
+
+void DecodeurAudio::chercher(double secondes) {
+    const AVStream *flux = format->streams[indexFlux];
+    const int64_t debutFlux = flux->start_time != AV_NOPTS_VALUE ? flux->start_time : 0;
+
+    const int64_t horodatage = debutFlux + av_rescale_q(llround(max(0.0, secondes) * AV_TIME_BASE),
+                                                        AV_TIME_BASE_Q, flux->time_base);
+
+    // Se place sur le dernier paquet précédant la position, l'excédent étant écarté au décodage.
+    const int code = av_seek_frame(format, indexFlux, horodatage, AVSEEK_FLAG_BACKWARD);
+    if (code < 0) throw runtime_error(messageErreur("Déplacement impossible dans le flux audio", code));
+
+    // Oublie tout ce qui était en cours de décodage ou de conversion.
+    avcodec_flush_buffers(decodeur);
+    swr_close(reechantillonneur);
+    if (swr_init(reechantillonneur) < 0) throw runtime_error("Réinitialisation du rééchantillonnage impossible.");
+
+    reliquat.clear();
+    positionReliquat = 0;
+    termine = false;
+
+    positionDemandee = max(0.0, secondes);
+    alignementEnAttente = true;
+    echantillonsASauter = 0;
+}
+
+void DecodeurAudio::lireTout(vector<float> &sortie, double dureeMax) {
+    sortie.resize(static_cast<size_t>(dureeMax * frequence));
+    sortie.resize(lire(sortie));
+}
+
+double DecodeurAudio::mesurerDuree(const string &fichier) {
+    AVFormatContext *contexte = nullptr;
+
+    int code = avformat_open_input(&contexte, fichier.c_str(), nullptr, nullptr);
+    if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir : " + fichier, code));
+
+    code = avformat_find_stream_info(contexte, nullptr);
+
+    const int64_t duree = code >= 0 ? contexte->duration : AV_NOPTS_VALUE;
+    avformat_close_input(&contexte);
+
+    if (code < 0) throw runtime_error(messageErreur("Flux illisibles : " + fichier, code));
+
+    return duree == AV_NOPTS_VALUE ? -1.0 : static_cast<double>(duree) / AV_TIME_BASE;
+}
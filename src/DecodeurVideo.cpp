@@ -0,0 +1,249 @@
+/**
+ * @file DecodeurVideo.cpp
+ * @brief Implémentation du décodage vidéo via libavformat et libavcodec.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurVideo.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/error.h>
+}
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Construit un message d'erreur lisible à partir d'un code d'erreur FFmpeg.
+     */
+    string messageErreur(const string &contexte, int code) {
+        char description[256];
+        av_strerror(code, description, sizeof(description));
+        return contexte + " (" + description + ")";
+    }
+
+    /**
+     * @brief Écart toléré entre la cadence conservée et la cadence utile (59,94 images/s divisées par deux suffisent à 30).
+     */
+    constexpr double TOLERANCE_CADENCE = 0.01;
+
+    /**
+     * @brief Choisit la réduction la plus forte qui garde des images au moins aussi grandes et rapides que l'usage.
+     */
+    DecodeurVideo::Reduction choisirReduction(AVFormatContext *format, AVStream *flux, const AVCodec *codec,
+                                              int largeurUtile, int hauteurUtile, double cadenceUtile,
+                                              bool ecarterImagesB) {
+        DecodeurVideo::Reduction reduction;
+        const int largeur = flux->codecpar->width;
+        const int hauteur = flux->codecpar->height;
+
+        if (largeurUtile > 0 && hauteurUtile > 0) {
+            while (reduction.resolution < codec->max_lowres
+                   && (largeur >> (reduction.resolution + 1)) >= largeurUtile
+                   && (hauteur >> (reduction.resolution + 1)) >= hauteurUtile) {
+                ++reduction.resolution;
+            }
+        }
+
+        // skip_frame écarte toutes les images non référencées. Sans images B (video_delay nul), ce sont au plus
+        // des images P jetables, une sur deux. Avec images B, une série IBBP n'en garde qu'une sur trois, et le
+        // nombre d'images B consécutives n'est pas connu d'avance : au pire video_delay + 1 par image gardée.
+        // Elles ne sont écartées que sur demande, et si la cadence conservée au pire suffit encore à la sortie.
+        const int retard = flux->codecpar->video_delay;
+        const int diviseur = retard == 0 ? 2 : retard + 2;
+        const AVRational cadence = av_guess_frame_rate(format, flux, nullptr);
+        reduction.nonReferencees = cadenceUtile > 0.0 && cadence.num > 0 && cadence.den > 0
+                                   && (retard == 0 || ecarterImagesB)
+                                   && av_q2d(cadence) / diviseur >= (1.0 - TOLERANCE_CADENCE) * cadenceUtile;
+
+        reduction.largeur = -((-largeur) >> reduction.resolution);
+        reduction.hauteur = -((-hauteur) >> reduction.resolution);
+
+        return reduction;
+    }
+}
+
+DecodeurVideo::DecodeurVideo(const string &fichier, int threads, int largeurUtile, int hauteurUtile,
+                             double cadenceUtile, bool ecarterImagesB) {
+    try {
+        int code = avformat_open_input(&format, fichier.c_str(), nullptr, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir : " + fichier, code));
+
+        code = avformat_find_stream_info(format, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Flux illisibles : " + fichier, code));
+
+        const AVCodec *codec = nullptr;
+        indexFlux = av_find_best_stream(format, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+        if (indexFlux < 0 || !codec) throw runtime_error("Aucune piste vidéo dans : " + fichier);
+
+        // Seul le flux vidéo est démultiplexé.
+        for (unsigned int i = 0; i < format->nb_streams; ++i) {
+            if (static_cast<int>(i) != indexFlux) format->streams[i]->discard = AVDISCARD_ALL;
+        }
+
+        decodeur = avcodec_alloc_context3(codec);
+        if (!decodeur) throw runtime_error("Allocation du décodeur impossible.");
+
+        code = avcodec_parameters_to_context(decodeur, format->streams[indexFlux]->codecpar);
+        if (code < 0) throw runtime_error(messageErreur("Paramètres vidéo invalides : " + fichier, code));
+
+        decodeur->thread_count = threads;
+
+        // Les images sont réduites au décodage plutôt que décodées entières puis réduites à la mise à l'échelle.
+        reduction = choisirReduction(format, format->streams[indexFlux], codec, largeurUtile, hauteurUtile,
+                                     cadenceUtile, ecarterImagesB);
+        decodeur->lowres = reduction.resolution;
+        if (reduction.nonReferencees) decodeur->skip_frame = AVDISCARD_NONREF;
+
+        code = avcodec_open2(decodeur, codec, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Ouverture du décodeur impossible : " + fichier, code));
+
+        paquet = av_packet_alloc();
+        courante = av_frame_alloc();
+        suivante = av_frame_alloc();
+        if (!paquet || !courante || !suivante) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+    } catch (...) {
+        liberer();
+        throw;
+    }
+}
+
+DecodeurVideo::~DecodeurVideo() {
+    liberer();
+}
+
+void DecodeurVideo::liberer() {
+    av_frame_free(&suivante);
+    av_frame_free(&courante);
+    av_packet_free(&paquet);
+    avcodec_free_context(&decodeur);
+    avformat_close_input(&format);
+}
+
+double DecodeurVideo::instant(const AVFrame *image) const {
+    const AVStream *flux = format->streams[indexFlux];
+    const int64_t debutFlux = flux->start_time != AV_NOPTS_VALUE ? flux->start_time : 0;
+
+    if (image->best_effort_timestamp == AV_NOPTS_VALUE) return 0.0;
+
+    return (image->best_effort_timestamp - debutFlux) * av_q2d(flux->time_base);
+}
+
+bool DecodeurVideo::decoderSuivante() {
+    av_frame_unref(suivante);
+    suivantePrete = false;
+
+    while (!termine) {
+        int code = avcodec_receive_frame(decodeur, suivante);
+
+        if (code >= 0) {
+            suivantePrete = true;
+            return true;
+        }
+
+        if (code == AVERROR_EOF) {
+            termine = true;
+            break;
+        }
+
+        if (code != AVERROR(EAGAIN)) throw runtime_error(messageErreur("Erreur de décodage vidéo", code));
+
+        // Le décodeur attend des données : lit le prochain paquet vidéo.
+        code = av_read_frame(format, paquet);
+
+        if (code == AVERROR_EOF) {
+            avcodec_send_packet(decodeur, nullptr);
+            continue;
+        }
+
+        if (code < 0) throw runtime_error(messageErreur("Erreur de lecture du conteneur", code));
+
+        if (paquet->stream_index == indexFlux) {
+            Metriques::compterOctets(paquet->size);
+
+            code = avcodec_send_packet(decodeur, paquet);
+            // Un paquet corrompu est ignoré, comme le ferait la ligne de commande ffmpeg.
+            if (code < 0 && code != AVERROR_INVALIDDATA && code != AVERROR(EAGAIN)) {
+                av_packet_unref(paquet);
+                throw runtime_error(messageErreur("Erreur de décodage vidéo", code));
+            }
+        }
+
+        av_packet_unref(paquet);
+    }
+
+    return false;
+}
+
+void DecodeurVideo::chercher(double secondes) {
+    const AVStream *flux = format->streams[indexFlux];
+    const int64_t debutFlux = flux->start_time != AV_NOPTS_VALUE ? flux->start_time : 0;
+
+    const int64_t horodatage = debutFlux + av_rescale_q(llround(max(0.0, secondes) * AV_TIME_BASE),
+                                                        AV_TIME_BASE_Q, flux->time_base);
+
+    // Se place sur l'image clé précédant la position ; les images antérieures seront décodées puis écartées.
+    const int code = av_seek_frame(format, indexFlux, horodatage, AVSEEK_FLAG_BACKWARD);
+    if (code < 0) throw runtime_error(messageErreur("Déplacement impossible dans le flux vidéo", code));
+
+    avcodec_flush_buffers(decodeur);
+
+    av_frame_unref(courante);
+    av_frame_unref(suivante);
+    courantePrete = false;
+    suivantePrete = false;
+    termine = false;
+}
+
+const AVFrame *DecodeurVideo::obtenirImage(double secondes) {
+    if (!courantePrete && !suivantePrete) {
+        // Premier appel après ouverture ou déplacement.
+        if (!decoderSuivante()) return nullptr;
+    }
+
+    // Avance tant que l'image suivante doit déjà être affichée.
+    while (suivantePrete && (!courantePrete || instant(suivante) <= secondes)) {
+        swap(courante, suivante);
+        courantePrete = true;
+
+        decoderSuivante();
+    }
+
+    return courantePrete ? courante : nullptr;
+}
+
+const DecodeurVideo::Reduction &DecodeurVideo::obtenirReduction() const {
+    return reduction;
+}
+
+DecodeurVideo::Reduction DecodeurVideo::sonder(const string &fichier, int largeurUtile, int hauteurUtile,
+                                               double cadenceUtile, bool ecarterImagesB) {
+    AVFormatContext *contexte = nullptr;
+
+    int code = avformat_open_input(&contexte, fichier.c_str(), nullptr, nullptr);
+    if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir : " + fichier, code));
+
+    try {
+        code = avformat_find_stream_info(contexte, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Flux illisibles : " + fichier, code));
+
+        const AVCodec *codec = nullptr;
+        const int index = av_find_best_stream(contexte, AVMEDIA_TYPE_VIDEO, -1, -1, &codec, 0);
+        if (index < 0 || !codec) throw runtime_error("Aucune piste vidéo dans : " + fichier);
+
+        const Reduction reduction = choisirReduction(contexte, contexte->streams[index], codec, largeurUtile,
+                                                     hauteurUtile, cadenceUtile, ecarterImagesB);
+        avformat_close_input(&contexte);
+
+        return reduction;
+    } catch (...) {
+        avformat_close_input(&contexte);
+        throw;
+    }
+}
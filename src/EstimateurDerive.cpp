@@ -0,0 +1,186 @@
+/**
+ * @file EstimateurDerive.cpp
+ * @brief Implémentation du suivi de décalage par fenêtres et de l'ajustement de la dérive.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/EstimateurDerive.h"
+#include "../include/ClassSynchroniseurMultiVideo/CorrelateurFFT.h"
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurAudio.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+#include "../include/ClassSynchroniseurMultiVideo/NoyauxCorrelation.h"
+#include "../include/ClassSynchroniseurMultiVideo/PoolThreads.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+EstimateurDerive::EstimateurDerive(int frequence, double dureeFenetre, double intervalle, double plage)
+    : frequence(frequence), dureeFenetre(dureeFenetre), intervalle(intervalle), plage(plage) {
+    if (frequence <= 0 || dureeFenetre <= 0.0 || intervalle <= 0.0 || plage <= 0.0) {
+        throw invalid_argument("Paramètres de suivi de dérive invalides.");
+    }
+}
+
+void EstimateurDerive::configurerMetriques(Metriques *metriques) {
+    this->metriques = metriques;
+}
+
+vector<EstimateurDerive::Mesure> EstimateurDerive::mesurer(const string &fichierRef, const string &fichierCible,
+                                                           double retardInitial, size_t premiere,
+                                                           size_t derniere) const {
+    Metriques::Etape etape(metriques, "derive", fichierCible);
+
+    const NoyauxCorrelation &noyaux = NoyauxCorrelation::obtenir();
+
+    DecodeurAudio decodeurRef(fichierRef, frequence);
+    DecodeurAudio decodeurCible(fichierCible, frequence);
+
+    const auto n = static_cast<size_t>(llround(dureeFenetre * frequence));
+    const auto marge = static_cast<size_t>(llround(plage * frequence));
+
+    // Tampons et plan FFT réutilisés pour toutes les fenêtres de la tranche.
+    vector<float> bloc(n);
+    vector<float> segment(n + 2 * marge);
+    CorrelateurFFT correlateur;
+    vector<double> correlation;
+
+    vector<Mesure> mesures;
+
+    for (size_t k = premiere; k < derniere; ++k) {
+        const double debut = k * intervalle;
+
+        decodeurRef.chercher(debut);
+        if (decodeurRef.lire(bloc) < n) continue;
+
+        // L'indice 0 du segment correspond à l'instant debutCible de la cible (zéros avant son début).
+        const double debutCible = debut + retardInitial - static_cast<double>(marge) / frequence;
+        const size_t avance = debutCible < 0.0 ? static_cast<size_t>(llround(-debutCible * frequence)) : 0;
+
+        if (avance >= segment.size()) continue;
+
+        fill(segment.begin(), segment.begin() + avance, 0.0f);
+
+        decodeurCible.chercher(max(0.0, debutCible));
+        const size_t lus = decodeurCible.lire(span(segment).subspan(avance));
+        fill(segment.begin() + avance + lus, segment.end(), 0.0f);
+
+        correlateur.correler(bloc, segment, 0, 2 * static_cast<ptrdiff_t>(marge), correlation);
+
+        const auto indice = static_cast<size_t>(max_element(correlation.begin(), correlation.end())
+                                                - correlation.begin());
+
+        // Pic en bord de plage : le vrai maximum est au-delà, la fenêtre n'est pas fiable.
+        if (indice == 0 || indice + 1 == correlation.size()) continue;
+
+        const double energie = noyaux.produitScalaire(bloc.data(), bloc.data(), n)
+                               * noyaux.produitScalaire(segment.data() + indice, segment.data() + indice, n);
+
+        if (energie <= 0.0) continue;
+
+        const double score = correlation[indice] / sqrt(energie);
+        if (score < SCORE_MINIMUM) continue;
+
+        // Interpolation parabolique sur le pic et ses deux voisins.
+        double pic = static_cast<double>(indice);
+        const double gauche = correlation[indice - 1];
+        const double centre = correlation[indice];
+        const double droite = correlation[indice + 1];
+        const double courbure = gauche - 2.0 * centre + droite;
+
+        if (courbure < 0.0) pic += 0.5 * (gauche - droite) / courbure;
+
+        mesures.push_back({
+            debut + dureeFenetre / 2.0,
+            retardInitial + (pic - static_cast<double>(marge)) / frequence,
+            score
+        });
+    }
+
+    return mesures;
+}
+
+EstimateurDerive::Modele EstimateurDerive::ajuster(vector<Mesure> mesures) {
+    double retard = 0.0, derive = 0.0;
+
+    while (true) {
+        if (mesures.size() < 2) throw runtime_error("Trop peu de fenêtres exploitables pour estimer la dérive.");
+
+        // Moindres carrés pondérés de retard = a + b * instant.
+        double sw = 0.0, swt = 0.0, swr = 0.0, swtt = 0.0, swtr = 0.0;
+
+        for (const Mesure &mesure: mesures) {
+            sw += mesure.score;
+            swt += mesure.score * mesure.instant;
+            swr += mesure.score * mesure.retard;
+            swtt += mesure.score * mesure.instant * mesure.instant;
+            swtr += mesure.score * mesure.instant * mesure.retard;
+        }
+
+        const double determinant = sw * swtt - swt * swt;
+        if (determinant <= 0.0) throw runtime_error("Fenêtres trop rapprochées pour estimer la dérive.");
+
+        derive = (sw * swtr - swt * swr) / determinant;
+        retard = (swr - derive * swt) / sw;
+
+        // Les fenêtres incohérentes sont écartées, puis le modèle est réajusté sur les autres.
+        const size_t avant = mesures.size();
+
+        erase_if(mesures, [&](const Mesure &mesure) {
+            return abs(mesure.retard - (retard + derive * mesure.instant)) > TOLERANCE;
+        });
+
+        if (mesures.size() == avant) break;
+    }
+
+    double somme = 0.0;
+    for (const Mesure &mesure: mesures) {
+        const double ecart = mesure.retard - (retard + derive * mesure.instant);
+        somme += ecart * ecart;
+    }
+
+    return {retard, derive, sqrt(somme / mesures.size()), static_cast<int>(mesures.size())};
+}
+
+EstimateurDerive::Modele EstimateurDerive::estimer(const string &fichierRef, const string &fichierCible,
+                                                   double retardInitial, size_t threads) const {
+    const double dureeRef = DecodeurAudio::mesurerDuree(fichierRef);
+    const double dureeCible = DecodeurAudio::mesurerDuree(fichierCible);
+
+    if (dureeRef <= 0.0 || dureeCible <= 0.0) throw runtime_error("Durée inconnue : dérive non estimée.");
+
+    // Fenêtres de la référence dont l'homologue tient entièrement dans la cible.
+    const auto premiere = static_cast<size_t>(ceil(max(0.0, -retardInitial) / intervalle));
+    const double finFenetres = min(dureeRef, dureeCible - retardInitial) - dureeFenetre;
+
+    if (finFenetres < 0.0) throw runtime_error("Recouvrement trop court pour estimer la dérive.");
+
+    const auto derniere = max(premiere, static_cast<size_t>(floor(finFenetres / intervalle)) + 1);
+    const size_t nombre = derniere - premiere;
+
+    if (nombre < 2) throw runtime_error("Recouvrement trop court pour estimer la dérive.");
+
+    // Une tranche contiguë de fenêtres par thread : chaque tranche avance dans ses fichiers sans revenir en arrière.
+    const size_t taillePool = min(nombre, threads == 0 ? max<size_t>(1, thread::hardware_concurrency()) : threads);
+    const size_t parTranche = (nombre + taillePool - 1) / taillePool;
+
+    PoolThreads pool(taillePool);
+    vector<future<vector<Mesure> > > tranches;
+
+    for (size_t debut = premiere; debut < derniere; debut += parTranche) {
+        const size_t fin = min(derniere, debut + parTranche);
+
+        tranches.push_back(pool.soumettre([this, &fichierRef, &fichierCible, retardInitial, debut, fin] {
+            return mesurer(fichierRef, fichierCible, retardInitial, debut, fin);
+        }));
+    }
+
+    vector<Mesure> mesures;
+    for (auto &tranche: tranches) {
+        const vector<Mesure> resultat = tranche.get();
+        mesures.insert(mesures.end(), resultat.begin(), resultat.end());
+    }
+
+    return ajuster(std::move(mesures));
+}
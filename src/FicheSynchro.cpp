@@ -0,0 +1,136 @@
+/**
+ * @file FicheSynchro.cpp
+ * @brief Implémentation de l'écriture des fiches de synchronisation.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/FicheSynchro.h"
+
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Chaîne JSON entre guillemets, caractères spéciaux échappés.
+     */
+    string chaineJSON(const string &texte) {
+        string resultat = "\"";
+
+        for (const char c: texte) {
+            switch (c) {
+                case '"': resultat += "\\\"";
+                    break;
+                case '\\': resultat += "\\\\";
+                    break;
+                case '\n': resultat += "\\n";
+                    break;
+                case '\t': resultat += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        snprintf(code, sizeof(code), "\\u%04x", c);
+                        resultat += code;
+                    } else {
+                        resultat += c;
+                    }
+            }
+        }
+
+        return resultat + "\"";
+    }
+
+    /**
+     * @brief Nombre JSON, null pour une valeur infinie.
+     */
+    string nombreJSON(double valeur) {
+        if (!isfinite(valeur)) return "null";
+
+        ostringstream flux;
+        flux << fixed << setprecision(6) << valeur;
+        return flux.str();
+    }
+
+    /**
+     * @brief Code temporel HH:MM:SS:II à la cadence donnée.
+     */
+    string codeTemporel(double secondes, int imagesParSeconde) {
+        const int64_t images = llround(max(0.0, secondes) * imagesParSeconde);
+        const int64_t totalSecondes = images / imagesParSeconde;
+
+        char code[32];
+        snprintf(code, sizeof(code), "%02lld:%02lld:%02lld:%02lld",
+                 static_cast<long long>(totalSecondes / 3600), static_cast<long long>(totalSecondes / 60 % 60),
+                 static_cast<long long>(totalSecondes % 60), static_cast<long long>(images % imagesParSeconde));
+        return code;
+    }
+}
+
+void FicheSynchro::ecrire(const string &fichier, const vector<Element> &elements, double duree,
+                          int imagesParSeconde) {
+    ofstream flux(fichier);
+    if (!flux) throw runtime_error("Impossible d'écrire la fiche de synchronisation : " + fichier);
+
+    if (filesystem::path(fichier).extension() == ".edl") {
+        ecrireEDL(flux, elements, imagesParSeconde);
+    } else {
+        ecrireJSON(flux, elements, duree, imagesParSeconde);
+    }
+
+    if (!flux) throw runtime_error("Impossible d'écrire la fiche de synchronisation : " + fichier);
+}
+
+void FicheSynchro::ecrireJSON(ostream &flux, const vector<Element> &elements, double duree,
+                              int imagesParSeconde) {
+    flux << "{\n"
+            << "  \"duree\": " << nombreJSON(duree) << ",\n"
+            << "  \"imagesParSeconde\": " << imagesParSeconde << ",\n"
+            << "  \"sources\": [";
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const Element &element = elements[i];
+
+        flux << (i > 0 ? "," : "") << "\n    {\n"
+                << "      \"chemin\": " << chaineJSON(element.chemin) << ",\n"
+                << "      \"type\": \"" << (element.video ? "video" : "audio") << "\",\n"
+                << "      \"retard\": " << nombreJSON(element.retard) << ",\n"
+                << "      \"confiance\": " << nombreJSON(element.confiance) << ",\n"
+                << "      \"derive\": " << nombreJSON(element.derive) << ",\n"
+                << "      \"debutLecture\": " << nombreJSON(element.placement.debutLecture) << ",\n"
+                << "      \"delai\": " << nombreJSON(element.placement.delai) << ",\n"
+                << "      \"duree\": " << nombreJSON(element.placement.duree) << "\n"
+                << "    }";
+    }
+
+    flux << "\n  ]\n}\n";
+}
+
+void FicheSynchro::ecrireEDL(ostream &flux, const vector<Element> &elements, int imagesParSeconde) {
+    flux << "TITLE: Synchronisation multi-vidéo\n"
+            << "FCM: NON-DROP FRAME\n\n";
+
+    for (size_t i = 0; i < elements.size(); ++i) {
+        const Element &element = elements[i];
+        const Chronologie::Placement &placement = element.placement;
+
+        // Une source de durée inconnue est bornée à une heure, le format exigeant un point de sortie.
+        const double duree = isfinite(placement.duree) ? placement.duree : 3600.0;
+
+        char numero[8];
+        snprintf(numero, sizeof(numero), "%03zu", i + 1);
+
+        flux << numero << "  AX       " << (element.video ? "V " : "A ") << "    C        "
+                << codeTemporel(placement.debutLecture, imagesParSeconde) << " "
+                << codeTemporel(placement.debutLecture + duree, imagesParSeconde) << " "
+                << codeTemporel(placement.delai, imagesParSeconde) << " "
+                << codeTemporel(placement.delai + duree, imagesParSeconde) << "\n"
+                << "* FROM CLIP NAME: " << filesystem::path(element.chemin).filename().string() << "\n"
+                << "* SOURCE FILE: " << element.chemin << "\n\n";
+    }
+}
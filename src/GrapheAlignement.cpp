@@ -0,0 +1,170 @@
+/**
+ * @file GrapheAlignement.cpp
+ * @brief Implémentation du solveur de chronologie globale.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/GrapheAlignement.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+using namespace std;
+
+GrapheAlignement::GrapheAlignement(size_t nbNoeuds) : nbNoeuds(nbNoeuds) {
+}
+
+void GrapheAlignement::ajouterMesure(size_t i, size_t j, double retard, double confiance) {
+    if (i >= nbNoeuds || j >= nbNoeuds || i == j) throw invalid_argument("Mesure d'alignement invalide.");
+
+    mesures.push_back({i, j, retard, confiance});
+}
+
+vector<double> GrapheAlignement::resoudreMoindresCarres(const vector<bool> &actives,
+                                                        const vector<bool> &connectes) const {
+    // Inconnues : les nœuds connectés autres que 0 (fixé à zéro).
+    vector<size_t> inconnue(nbNoeuds, nbNoeuds);
+    size_t n = 0;
+    for (size_t k = 1; k < nbNoeuds; ++k) {
+        if (connectes[k]) inconnue[k] = n++;
+    }
+
+    // Équations normales : laplacien pondéré du graphe, réduit en retirant le nœud 0.
+    vector<vector<double> > matrice(n, vector<double>(n, 0.0));
+    vector<double> secondMembre(n, 0.0);
+
+    for (size_t m = 0; m < mesures.size(); ++m) {
+        if (!actives[m]) continue;
+
+        const Mesure &mesure = mesures[m];
+        const double poids = mesure.confiance * mesure.confiance;
+        const size_t a = inconnue[mesure.i];
+        const size_t b = inconnue[mesure.j];
+
+        // Résidu : x_j - x_i - retard.
+        if (a < n) {
+            matrice[a][a] += poids;
+            secondMembre[a] -= poids * mesure.retard;
+        }
+        if (b < n) {
+            matrice[b][b] += poids;
+            secondMembre[b] += poids * mesure.retard;
+        }
+        if (a < n && b < n) {
+            matrice[a][b] -= poids;
+            matrice[b][a] -= poids;
+        }
+    }
+
+    // Élimination de Gauss avec pivot partiel ; la matrice est définie positive sur une composante connexe.
+    for (size_t c = 0; c < n; ++c) {
+        size_t pivot = c;
+        for (size_t l = c + 1; l < n; ++l) {
+            if (abs(matrice[l][c]) > abs(matrice[pivot][c])) pivot = l;
+        }
+
+        swap(matrice[c], matrice[pivot]);
+        swap(secondMembre[c], secondMembre[pivot]);
+
+        for (size_t l = c + 1; l < n; ++l) {
+            const double facteur = matrice[l][c] / matrice[c][c];
+            if (facteur == 0.0) continue;
+
+            for (size_t k = c; k < n; ++k) matrice[l][k] -= facteur * matrice[c][k];
+            secondMembre[l] -= facteur * secondMembre[c];
+        }
+    }
+
+    vector<double> solution(n, 0.0);
+    for (size_t c = n; c-- > 0;) {
+        double somme = secondMembre[c];
+        for (size_t k = c + 1; k < n; ++k) somme -= matrice[c][k] * solution[k];
+        solution[c] = somme / matrice[c][c];
+    }
+
+    vector<double> retards(nbNoeuds, 0.0);
+    for (size_t k = 1; k < nbNoeuds; ++k) {
+        if (inconnue[k] < n) retards[k] = solution[inconnue[k]];
+    }
+
+    return retards;
+}
+
+vector<GrapheAlignement::Position> GrapheAlignement::resoudre(double confianceMin, double toleranceSecondes) const {
+    // Arbre couvrant de confiance maximale (Kruskal) : il définit la connexité et ne sera jamais élagué.
+    vector<size_t> ordre(mesures.size());
+    iota(ordre.begin(), ordre.end(), 0);
+    sort(ordre.begin(), ordre.end(), [this](size_t a, size_t b) {
+        return mesures[a].confiance > mesures[b].confiance;
+    });
+
+    vector<size_t> parent(nbNoeuds);
+    iota(parent.begin(), parent.end(), 0);
+
+    const auto racine = [&parent](size_t k) {
+        while (parent[k] != k) k = parent[k] = parent[parent[k]];
+        return k;
+    };
+
+    vector<bool> dansArbre(mesures.size(), false);
+    vector<bool> actives(mesures.size(), false);
+
+    for (const size_t m: ordre) {
+        if (mesures[m].confiance < confianceMin) break;
+
+        actives[m] = true;
+
+        const size_t a = racine(mesures[m].i);
+        const size_t b = racine(mesures[m].j);
+
+        if (a != b) {
+            parent[a] = b;
+            dansArbre[m] = true;
+        }
+    }
+
+    vector<bool> connectes(nbNoeuds, false);
+    for (size_t k = 0; k < nbNoeuds; ++k) connectes[k] = racine(k) == racine(0);
+
+    vector<double> retards = resoudreMoindresCarres(actives, connectes);
+
+    // Les mesures hors arbre incohérentes avec la première solution (faux pics) sont écartées.
+    bool elagage = false;
+    for (size_t m = 0; m < mesures.size(); ++m) {
+        if (!actives[m] || dansArbre[m]) continue;
+
+        const Mesure &mesure = mesures[m];
+        if (abs(retards[mesure.j] - retards[mesure.i] - mesure.retard) > toleranceSecondes) {
+            actives[m] = false;
+            elagage = true;
+        }
+    }
+
+    if (elagage) retards = resoudreMoindresCarres(actives, connectes);
+
+    vector<Position> positions(nbNoeuds);
+    vector<double> sommeCarres(nbNoeuds, 0.0);
+    vector<int> nbMesures(nbNoeuds, 0);
+
+    for (size_t k = 0; k < nbNoeuds; ++k) positions[k] = {connectes[k], retards[k], k == 0 ? 1.0 : 0.0, 0.0};
+
+    for (size_t m = 0; m < mesures.size(); ++m) {
+        if (!actives[m]) continue;
+
+        const Mesure &mesure = mesures[m];
+        const double residu = retards[mesure.j] - retards[mesure.i] - mesure.retard;
+
+        for (const size_t k: {mesure.i, mesure.j}) {
+            positions[k].confiance = max(positions[k].confiance, mesure.confiance);
+            sommeCarres[k] += residu * residu;
+            ++nbMesures[k];
+        }
+    }
+
+    for (size_t k = 0; k < nbNoeuds; ++k) {
+        if (nbMesures[k] > 0) positions[k].residu = sqrt(sommeCarres[k] / nbMesures[k]);
+    }
+
+    return positions;
+}
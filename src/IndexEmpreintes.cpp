@@ -0,0 +1,185 @@
+/**
+ * @file IndexEmpreintes.cpp
+ * @brief Implémentation de l'index d'empreintes audio par repères spectraux.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/IndexEmpreintes.h"
+#include "../include/ClassSynchroniseurMultiVideo/Decimateur.h"
+#include "../include/ClassSynchroniseurMultiVideo/TransformeeFourier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <numbers>
+
+using namespace std;
+
+namespace {
+    // Fréquence visée pour l'analyse spectrale : l'essentiel des repères exploitables se situe sous 5 kHz.
+    constexpr int FREQUENCE_ANALYSE = 11025;
+
+    constexpr int TAILLE_TRAME = 1024;
+    constexpr int PAS_TRAME = 256;
+
+    // Seuls les indices de fréquence [1, 512[ sont retenus (9 bits dans le hachage).
+    constexpr int NB_CASES = TAILLE_TRAME / 2;
+
+    // Un pic domine ses voisins sur ±VOISINAGE_FREQUENCE cases et ±VOISINAGE_TEMPS trames.
+    constexpr int VOISINAGE_FREQUENCE = 8;
+    constexpr int VOISINAGE_TEMPS = 3;
+
+    constexpr size_t PICS_PAR_TRAME = 5;
+
+    // Appariement : jusqu'à EVENTAIL pics cibles, dans les ECART_TRAMES_MAX trames suivantes (6 bits).
+    constexpr int ECART_TRAMES_MAX = 63;
+    constexpr int ECART_FREQUENCE_MAX = 64;
+    constexpr int EVENTAIL = 5;
+
+    // Un hachage présent trop souvent dans la référence (son tenu, bruit stationnaire) n'apporte aucune information.
+    constexpr ptrdiff_t OCCURRENCES_MAX = 64;
+
+    // Puissance minimale d'un pic : écarte le silence numérique.
+    constexpr float PUISSANCE_MIN = 1e-8f;
+
+    struct Pic {
+        int trame;
+        int frequence;
+    };
+
+    bool comparerHachage(const IndexEmpreintes::Repere &a, const IndexEmpreintes::Repere &b) {
+        return a.hachage < b.hachage;
+    }
+}
+
+IndexEmpreintes::IndexEmpreintes(span<const float> ref, int frequence)
+    : facteur(max(1, frequence / FREQUENCE_ANALYSE)) {
+    nbTrames = extraire(ref, reperes);
+    sort(reperes.begin(), reperes.end(), comparerHachage);
+}
+
+int IndexEmpreintes::obtenirPasTrame() const {
+    return PAS_TRAME * facteur;
+}
+
+int IndexEmpreintes::extraire(span<const float> signal, vector<Repere> &sortie) const {
+    sortie.clear();
+
+    vector<float> decime;
+    Decimateur(facteur).decimer(signal, decime);
+
+    if (decime.size() < static_cast<size_t>(TAILLE_TRAME)) return 0;
+
+    const int nbTramesSignal = static_cast<int>((decime.size() - TAILLE_TRAME) / PAS_TRAME) + 1;
+
+    vector<float> fenetre(TAILLE_TRAME);
+    for (int i = 0; i < TAILLE_TRAME; ++i) {
+        fenetre[i] = static_cast<float>(0.5 - 0.5 * cos(2.0 * numbers::pi * i / TAILLE_TRAME));
+    }
+
+    const TransformeeFourier plan(TAILLE_TRAME);
+    vector<complex<double> > tampon(TAILLE_TRAME);
+
+    // Seules les 2 * VOISINAGE_TEMPS + 1 dernières trames sont conservées : la mémoire ne dépend pas de la durée.
+    constexpr int PROFONDEUR = 2 * VOISINAGE_TEMPS + 1;
+    vector<vector<float> > puissances(PROFONDEUR, vector<float>(NB_CASES));
+    vector<vector<float> > maximaLocaux(PROFONDEUR, vector<float>(NB_CASES));
+
+    vector<Pic> pics;
+    vector<pair<float, int> > candidats;
+
+    // Sélectionne les pics de la trame t, dont les voisines [t - V, t + V] sont disponibles (bornées au signal).
+    const auto selectionner = [&](int t) {
+        const vector<float> &puissance = puissances[t % PROFONDEUR];
+        candidats.clear();
+
+        for (int f = 1; f < NB_CASES; ++f) {
+            const float valeur = puissance[f];
+            if (valeur < PUISSANCE_MIN || valeur < maximaLocaux[t % PROFONDEUR][f]) continue;
+
+            bool domine = true;
+            for (int u = max(0, t - VOISINAGE_TEMPS); u <= min(nbTramesSignal - 1, t + VOISINAGE_TEMPS) && domine; ++u) {
+                if (u != t && maximaLocaux[u % PROFONDEUR][f] > valeur) domine = false;
+            }
+
+            if (domine) candidats.emplace_back(valeur, f);
+        }
+
+        const size_t nbRetenus = min(PICS_PAR_TRAME, candidats.size());
+        partial_sort(candidats.begin(), candidats.begin() + nbRetenus, candidats.end(),
+                     [](const auto &a, const auto &b) { return a.first > b.first; });
+
+        for (size_t i = 0; i < nbRetenus; ++i) pics.push_back({t, candidats[i].second});
+    };
+
+    for (int t = 0; t < nbTramesSignal; ++t) {
+        const float *debut = decime.data() + static_cast<size_t>(t) * PAS_TRAME;
+        for (int i = 0; i < TAILLE_TRAME; ++i) tampon[i] = complex<double>(debut[i] * fenetre[i], 0.0);
+
+        plan.transformer(tampon);
+
+        vector<float> &puissance = puissances[t % PROFONDEUR];
+        for (int f = 0; f < NB_CASES; ++f) puissance[f] = static_cast<float>(norm(tampon[f]));
+
+        // Maximum sur le voisinage fréquentiel, réutilisé par les trames voisines pour le test temporel.
+        vector<float> &maxima = maximaLocaux[t % PROFONDEUR];
+        for (int f = 0; f < NB_CASES; ++f) {
+            const int fMin = max(0, f - VOISINAGE_FREQUENCE);
+            const int fMax = min(NB_CASES - 1, f + VOISINAGE_FREQUENCE);
+            maxima[f] = *max_element(puissance.begin() + fMin, puissance.begin() + fMax + 1);
+        }
+
+        if (t >= VOISINAGE_TEMPS) selectionner(t - VOISINAGE_TEMPS);
+    }
+
+    for (int t = max(0, nbTramesSignal - VOISINAGE_TEMPS); t < nbTramesSignal; ++t) selectionner(t);
+
+    // Appariement de chaque pic d'ancrage avec les premiers pics suivants proches en fréquence.
+    // Les pics sont rangés par trame croissante.
+    for (size_t a = 0; a < pics.size(); ++a) {
+        const Pic &ancre = pics[a];
+        int nbPaires = 0;
+
+        for (size_t b = a + 1; b < pics.size() && nbPaires < EVENTAIL; ++b) {
+            const int ecart = pics[b].trame - ancre.trame;
+
+            if (ecart > ECART_TRAMES_MAX) break;
+            if (ecart == 0 || abs(pics[b].frequence - ancre.frequence) > ECART_FREQUENCE_MAX) continue;
+
+            const uint32_t hachage = static_cast<uint32_t>(ancre.frequence) << 15
+                                     | static_cast<uint32_t>(pics[b].frequence) << 6
+                                     | static_cast<uint32_t>(ecart);
+
+            sortie.push_back({hachage, ancre.trame});
+            ++nbPaires;
+        }
+    }
+
+    return nbTramesSignal;
+}
+
+IndexEmpreintes::ResultatVote IndexEmpreintes::aligner(span<const float> cible) const {
+    vector<Repere> reperesCible;
+    const int nbTramesCible = extraire(cible, reperesCible);
+
+    ResultatVote resultat{0.0, 0, static_cast<int>(reperesCible.size())};
+
+    if (reperes.empty() || reperesCible.empty()) return resultat;
+
+    // Histogramme des écarts tc - tr, décalés de nbTrames pour rester positifs.
+    vector<int> histogramme(static_cast<size_t>(nbTrames) + nbTramesCible, 0);
+
+    for (const Repere &repere: reperesCible) {
+        const auto [debut, fin] = equal_range(reperes.begin(), reperes.end(), repere, comparerHachage);
+
+        if (fin - debut > OCCURRENCES_MAX) continue;
+
+        for (auto it = debut; it != fin; ++it) ++histogramme[repere.trame - it->trame + nbTrames];
+    }
+
+    const auto meilleur = max_element(histogramme.begin(), histogramme.end());
+
+    resultat.votes = *meilleur;
+    resultat.retard = static_cast<double>((meilleur - histogramme.begin()) - nbTrames) * obtenirPasTrame();
+
+    return resultat;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file LecteurAudioFlux.cpp
+ * @brief Implémentation de la lecture audio en flux à mémoire bornée.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/LecteurAudioFlux.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+LecteurAudioFlux::LecteurAudioFlux(const string &fichier, int frequence, size_t capacite, size_t tailleMorceau)
+    : decodeur(fichier, frequence), tampon(capacite), frequence(frequence), tailleMorceau(max<size_t>(tailleMorceau, 1)) {
+}
+
+void LecteurAudioFlux::chercher(double secondes) {
+    const int64_t position = llround(max(0.0, secondes) * frequence);
+
+    // Déjà positionné (par exemple à l'ouverture) : aucun déplacement dans le conteneur,
+    // ce qui permet aussi de lire les flux non indexés depuis leur début.
+    if (position != tampon.obtenirFin()) {
+        decodeur.chercher(secondes);
+        termine = false;
+    }
+
+    tampon.reinitialiser(position);
+}
+
+bool LecteurAudioFlux::remplir(int64_t position) {
+    while (tampon.obtenirFin() < position && !termine) {
+        const span<float> zone = tampon.zoneEcriture();
+        if (zone.empty()) throw logic_error("Tampon circulaire trop petit pour la fenêtre demandée.");
+
+        const span<float> morceau = zone.first(min(zone.size(), tailleMorceau));
+        const size_t lus = decodeur.lire(morceau);
+
+        tampon.valider(lus);
+
+        // Un morceau incomplet signale la fin du flux.
+        if (lus < morceau.size()) termine = true;
+    }
+
+    return tampon.obtenirFin() >= position;
+}
+
+bool LecteurAudioFlux::estTermine() const {
+    return termine;
+}
+
+const TamponCirculaire &LecteurAudioFlux::obtenirTampon() const {
+    return tampon;
+}
+
+void LecteurAudioFlux::liberer(int64_t position) {
+    tampon.liberer(position);
+}
@@ -0,0 +1,171 @@
+/**
+ * @file LotSynchronisation.cpp
+ * @brief Implémentation de l'ordonnancement des travaux d'un lot sur un pool partagé.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/LotSynchronisation.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+LotSynchronisation::LotSynchronisation(size_t analyses, size_t encodages, size_t threads)
+    : analysesSimultanees(max<size_t>(analyses, 1)), encodagesSimultanes(max<size_t>(encodages, 1)),
+      nombreThreads(threads) {
+}
+
+vector<bool> LotSynchronisation::executer(const vector<Travail> &travaux, const Analyse &analyser) const {
+    const size_t nombre = travaux.size();
+
+    // Rang de démarrage : priorité décroissante, puis ordre du lot.
+    vector<size_t> ordre(nombre);
+    iota(ordre.begin(), ordre.end(), 0);
+    stable_sort(ordre.begin(), ordre.end(), [&travaux](size_t a, size_t b) {
+        return travaux[a].priorite > travaux[b].priorite;
+    });
+
+    vector<bool> reussites(nombre, false);
+
+    // État partagé avec les tâches ; le pool, déclaré après, est arrêté avant sa destruction.
+    mutex verrou;
+    condition_variable evenement;
+    map<size_t, Encodage> prets; // Travaux analysés en attente d'encodage, par rang.
+    size_t enAnalyse = 0;
+    size_t enEncodage = 0;
+    size_t termines = 0;
+
+    PoolThreads pool(nombreThreads);
+
+    cout << "[Lot] " << nombre << " travaux sur " << pool.obtenirTaille() << " threads" << endl;
+
+    size_t prochain = 0;
+    unique_lock verrouillage(verrou);
+
+    while (termines < nombre) {
+        // Encodages d'abord : un travail analysé libère sa place d'analyse pour le suivant.
+        while (enEncodage < encodagesSimultanes && !prets.empty()) {
+            const size_t i = ordre[prets.begin()->first];
+            Encodage encodage = std::move(prets.begin()->second);
+            prets.erase(prets.begin());
+            ++enEncodage;
+
+            pool.soumettre([&, i, encodage = std::move(encodage)]() mutable {
+                bool reussi = false;
+
+                try {
+                    reussi = encodage();
+                } catch (const exception &e) {
+                    cerr << "[Erreur Lot] " << travaux[i].sortie << " : " << e.what() << endl;
+                } catch (...) {
+                    cerr << "[Erreur Lot] " << travaux[i].sortie << " : exception inconnue" << endl;
+                }
+
+                lock_guard fin(verrou);
+                reussites[i] = reussi;
+                --enEncodage;
+                ++termines;
+                evenement.notify_one();
+            }, travaux[i].priorite);
+        }
+
+        // L'analyse ne prend d'avance que sur analysesSimultanees travaux : l'encodage garde sa part du pool.
+        while (prochain < nombre && enAnalyse + prets.size() < analysesSimultanees) {
+            const size_t rang = prochain++;
+            const size_t i = ordre[rang];
+            ++enAnalyse;
+
+            cout << "[Lot] Analyse de " << travaux[i].sortie << " (priorité " << travaux[i].priorite << ")" << endl;
+
+            pool.soumettre([&, rang, i] {
+                Encodage encodage;
+
+                try {
+                    encodage = analyser(travaux[i], pool);
+                } catch (const exception &e) {
+                    cerr << "[Erreur Lot] " << travaux[i].sortie << " : " << e.what() << endl;
+                } catch (...) {
+                    cerr << "[Erreur Lot] " << travaux[i].sortie << " : exception inconnue" << endl;
+                }
+
+                lock_guard fin(verrou);
+                --enAnalyse;
+                if (encodage) {
+                    prets.emplace(rang, std::move(encodage));
+                } else {
+                    ++termines;
+                }
+                evenement.notify_one();
+            }, travaux[i].priorite);
+        }
+
+        evenement.wait(verrouillage);
+    }
+
+    verrouillage.unlock();
+
+    const size_t reussis = count(reussites.begin(), reussites.end(), true);
+    cout << "[Lot] " << reussis << "/" << nombre << " travaux réussis" << endl;
+
+    return reussites;
+}
+
+vector<LotSynchronisation::Travail> LotSynchronisation::lireManifeste(const string &fichier) {
+    ifstream flux(fichier);
+    if (!flux) throw runtime_error("Impossible d'ouvrir le manifeste : " + fichier);
+
+    vector<Travail> travaux;
+    string ligne;
+
+    for (size_t numero = 1; getline(flux, ligne); ++numero) {
+        istringstream mots(ligne);
+
+        mots >> ws;
+        if (mots.eof() || mots.peek() == '#') continue;
+
+        const string prefixe = "Ligne " + to_string(numero) + " : ";
+
+        Travail travail;
+        mots >> quoted(travail.sortie);
+
+        for (string mot; mots >> quoted(mot);) {
+            const size_t egal = mot.find('=');
+            const string cle = egal == string::npos ? "" : mot.substr(0, egal);
+            const string valeur = egal == string::npos ? "" : mot.substr(egal + 1);
+
+            try {
+                if (cle == "priorite") {
+                    travail.priorite = stoi(valeur);
+                } else if (cle == "parallelisme") {
+                    travail.parallelisme = static_cast<unsigned int>(stoul(valeur));
+                } else if (cle == "audio") {
+                    travail.audioRef = valeur;
+                } else if (cle == "fiche") {
+                    travail.fiche = valeur;
+                } else {
+                    travail.videos.push_back(mot);
+                }
+            } catch (const logic_error &) {
+                throw runtime_error(prefixe + "valeur invalide pour " + cle + " (" + valeur + ")");
+            }
+        }
+
+        const size_t minimum = travail.audioRef.empty() ? 2 : 1;
+        if (travail.videos.size() < minimum) {
+            throw runtime_error(prefixe + "il faut au moins " + to_string(minimum) + " vidéo(s) pour "
+                                + travail.sortie);
+        }
+
+        travaux.push_back(std::move(travail));
+    }
+
+    return travaux;
+}
@@ -0,0 +1,289 @@
+/**
+ * @file Metriques.cpp
+ * @brief Implémentation des mesures d'étapes et des rapports JSON et Chrome Trace.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Échappe une chaîne pour JSON.
+     */
+    string chaineJSON(const string &texte) {
+        string resultat = "\"";
+
+        for (const char c: texte) {
+            switch (c) {
+                case '"': resultat += "\\\"";
+                    break;
+                case '\\': resultat += "\\\\";
+                    break;
+                case '\n': resultat += "\\n";
+                    break;
+                case '\t': resultat += "\\t";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        snprintf(code, sizeof(code), "\\u%04x", c);
+                        resultat += code;
+                    } else {
+                        resultat += c;
+                    }
+            }
+        }
+
+        return resultat + "\"";
+    }
+
+    /**
+     * @brief Écrit les champs de travail communs à une étape et à un total.
+     */
+    void ecrireTravail(ostream &flux, int64_t duree, int64_t cpu, const Metriques::Compteurs &travail) {
+        const double secondes = duree * 1e-6;
+
+        flux << "\"duree\": " << secondes
+                << ", \"cpu\": " << cpu * 1e-6
+                << ", \"octets\": " << travail.octets
+                << ", \"echantillons\": " << travail.echantillons
+                << ", \"retards\": " << travail.retards
+                << ", \"octetsParSeconde\": " << (secondes > 0.0 ? travail.octets / secondes : 0.0)
+                << ", \"retardsParSeconde\": " << (secondes > 0.0 ? travail.retards / secondes : 0.0);
+    }
+
+#ifdef _WIN32
+    int64_t microsecondes(const FILETIME &noyau, const FILETIME &utilisateur) {
+        const auto valeur = [](const FILETIME &t) {
+            return (static_cast<int64_t>(t.dwHighDateTime) << 32) | t.dwLowDateTime;
+        };
+
+        // Unités de 100 ns.
+        return (valeur(noyau) + valeur(utilisateur)) / 10;
+    }
+#else
+    int64_t microsecondes(clockid_t horloge) {
+        timespec temps{};
+        clock_gettime(horloge, &temps);
+        return static_cast<int64_t>(temps.tv_sec) * 1000000 + temps.tv_nsec / 1000;
+    }
+#endif
+}
+
+thread_local Metriques::Compteurs Metriques::compteurs;
+
+Metriques::Metriques() : origine(chrono::steady_clock::now()) {
+}
+
+int64_t Metriques::tempsCPUThread() {
+#ifdef _WIN32
+    FILETIME creation, fin, noyau, utilisateur;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &fin, &noyau, &utilisateur)) return 0;
+    return microsecondes(noyau, utilisateur);
+#else
+    return microsecondes(CLOCK_THREAD_CPUTIME_ID);
+#endif
+}
+
+int64_t Metriques::tempsCPUProcessus() {
+#ifdef _WIN32
+    FILETIME creation, fin, noyau, utilisateur;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &fin, &noyau, &utilisateur)) return 0;
+    return microsecondes(noyau, utilisateur);
+#else
+    return microsecondes(CLOCK_PROCESS_CPUTIME_ID);
+#endif
+}
+
+int64_t Metriques::memoireMaximale() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS compteursMemoire{};
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &compteursMemoire, sizeof(compteursMemoire))) return 0;
+    return static_cast<int64_t>(compteursMemoire.PeakWorkingSetSize);
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+
+#ifdef __APPLE__
+    return usage.ru_maxrss; // Octets sous macOS.
+#else
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024; // Kio sous Linux.
+#endif
+#endif
+}
+
+Metriques::Etape::Etape(Metriques *metriques, string nom, string entree)
+    : metriques(metriques), nom(std::move(nom)), entree(std::move(entree)) {
+    if (!metriques) return;
+
+    debut = chrono::steady_clock::now();
+    cpuDebut = tempsCPUThread();
+    travailDebut = compteurs;
+}
+
+Metriques::Etape::~Etape() {
+    if (!metriques) return;
+
+    const auto fin = chrono::steady_clock::now();
+
+    Enregistrement enregistrement{
+        std::move(nom),
+        std::move(entree),
+        0,
+        chrono::duration_cast<chrono::microseconds>(debut - metriques->origine).count(),
+        chrono::duration_cast<chrono::microseconds>(fin - debut).count(),
+        tempsCPUThread() - cpuDebut,
+        {
+            compteurs.octets - travailDebut.octets,
+            compteurs.echantillons - travailDebut.echantillons,
+            compteurs.retards - travailDebut.retards
+        },
+        memoireMaximale()
+    };
+
+    // Un destructeur ne lève pas : une étape qui ne peut être enregistrée est perdue.
+    try {
+        metriques->enregistrer(std::move(enregistrement));
+    } catch (...) {
+    }
+}
+
+void Metriques::enregistrer(Enregistrement enregistrement) {
+    const size_t identifiant = hash<thread::id>{}(this_thread::get_id());
+
+    lock_guard verrouillage(verrou);
+
+    auto position = find(threads.begin(), threads.end(), identifiant);
+    if (position == threads.end()) position = threads.insert(threads.end(), identifiant);
+
+    enregistrement.thread = position - threads.begin();
+    enregistrements.push_back(std::move(enregistrement));
+}
+
+vector<Metriques::Enregistrement> Metriques::obtenirEnregistrements() const {
+    lock_guard verrouillage(verrou);
+    return enregistrements;
+}
+
+void Metriques::ecrireJSON(const string &fichier) const {
+    vector<Enregistrement> etapes = obtenirEnregistrements();
+    sort(etapes.begin(), etapes.end(), [](const Enregistrement &a, const Enregistrement &b) {
+        return a.debut < b.debut;
+    });
+
+    ofstream flux(fichier);
+    if (!flux) throw runtime_error("Impossible d'écrire les métriques : " + fichier);
+
+    // Durées en secondes, à la microseconde près même pour les longs rendus.
+    flux << setprecision(12);
+
+    const int64_t duree = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - origine).count();
+
+    flux << "{\n"
+            << "  \"duree\": " << duree * 1e-6 << ",\n"
+            << "  \"cpu\": " << tempsCPUProcessus() * 1e-6 << ",\n"
+            << "  \"memoireMax\": " << memoireMaximale() << ",\n"
+            << "  \"etapes\": [";
+
+    for (size_t i = 0; i < etapes.size(); ++i) {
+        const Enregistrement &etape = etapes[i];
+
+        flux << (i > 0 ? "," : "") << "\n    {\"nom\": " << chaineJSON(etape.nom)
+                << ", \"entree\": " << chaineJSON(etape.entree)
+                << ", \"thread\": " << etape.thread
+                << ", \"debut\": " << etape.debut * 1e-6 << ", ";
+        ecrireTravail(flux, etape.duree, etape.cpu, etape.travail);
+        flux << ", \"memoireMax\": " << etape.memoireMax << "}";
+    }
+
+    flux << "\n  ],\n  \"totaux\": [";
+
+    // Totaux par étape (toutes entrées confondues, entree vide) puis par étape et par entrée.
+    struct Total {
+        int nombre = 0;
+        int64_t duree = 0, cpu = 0;
+        Compteurs travail;
+    };
+
+    map<pair<string, string>, Total> totaux;
+
+    const auto cumuler = [](Total &total, const Enregistrement &etape) {
+        ++total.nombre;
+        total.duree += etape.duree;
+        total.cpu += etape.cpu;
+        total.travail.octets += etape.travail.octets;
+        total.travail.echantillons += etape.travail.echantillons;
+        total.travail.retards += etape.travail.retards;
+    };
+
+    for (const Enregistrement &etape: etapes) {
+        cumuler(totaux[{etape.nom, string()}], etape);
+        if (!etape.entree.empty()) cumuler(totaux[{etape.nom, etape.entree}], etape);
+    }
+
+    bool premier = true;
+
+    for (const auto &[cle, total]: totaux) {
+        flux << (premier ? "" : ",") << "\n    {\"nom\": " << chaineJSON(cle.first)
+                << ", \"entree\": " << chaineJSON(cle.second)
+                << ", \"nombre\": " << total.nombre << ", ";
+        ecrireTravail(flux, total.duree, total.cpu, total.travail);
+        flux << "}";
+
+        premier = false;
+    }
+
+    flux << "\n  ]\n}\n";
+
+    if (!flux) throw runtime_error("Impossible d'écrire les métriques : " + fichier);
+}
+
+void Metriques::ecrireTrace(const string &fichier) const {
+    const vector<Enregistrement> etapes = obtenirEnregistrements();
+
+    ofstream flux(fichier);
+    if (!flux) throw runtime_error("Impossible d'écrire la trace : " + fichier);
+
+    flux << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    for (size_t i = 0; i < etapes.size(); ++i) {
+        const Enregistrement &etape = etapes[i];
+
+        // Événement complet (ph = X) : début et durée en microsecondes.
+        flux << (i > 0 ? "," : "") << "\n  {\"name\": " << chaineJSON(etape.nom)
+                << ", \"cat\": \"synchro\", \"ph\": \"X\", \"pid\": 1"
+                << ", \"tid\": " << etape.thread
+                << ", \"ts\": " << etape.debut
+                << ", \"dur\": " << etape.duree
+                << ", \"args\": {\"entree\": " << chaineJSON(etape.entree)
+                << ", \"cpu_us\": " << etape.cpu
+                << ", \"octets\": " << etape.travail.octets
+                << ", \"echantillons\": " << etape.travail.echantillons
+                << ", \"retards\": " << etape.travail.retards
+                << ", \"memoireMax\": " << etape.memoireMax << "}}";
+    }
+
+    flux << "\n]}\n";
+
+    if (!flux) throw runtime_error("Impossible d'écrire la trace : " + fichier);
+}
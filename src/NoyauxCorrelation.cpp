@@ -0,0 +1,314 @@
+/**
+ * @file NoyauxCorrelation.cpp
+ * @brief Noyaux de corrélation scalaire, SSE2, AVX2/FMA et AVX-512 avec sélection à l'exécution.
+ *
+ * Chaque noyau vectoriel accumule en float par blocs de TAILLE_BLOC échantillons, puis reporte
+ * chaque bloc dans un accumulateur double : la précision reste proche de la version scalaire
+ * sans sacrifier la largeur des registres.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/NoyauxCorrelation.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#define SYNCHRO_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CIBLE_AVX2 __attribute__((target("avx2,fma")))
+#define CIBLE_AVX512 __attribute__((target("avx512f")))
+#else
+#define CIBLE_AVX2
+#define CIBLE_AVX512
+#endif
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Nombre d'échantillons accumulés en float avant report dans l'accumulateur double.
+     */
+    constexpr size_t TAILLE_BLOC = 4096;
+
+    /**
+     * @brief Nombre de retards traités simultanément par les noyaux glissants (lecture de ref partagée).
+     */
+    constexpr size_t RETARDS_PAR_PASSE = 4;
+
+    // --- Scalaire (repli hors x86) --------------------------------------------------------------
+
+    [[maybe_unused]] double produitScalaireScalaire(const float *a, const float *b, size_t n) {
+        double somme = 0.0;
+        for (size_t i = 0; i < n; ++i) somme += static_cast<double>(a[i]) * b[i];
+        return somme;
+    }
+
+    [[maybe_unused]] void correlationGlissanteScalaire(const float *ref, const float *cible, size_t n,
+                                                       size_t nbRetards, double *sortie) {
+        for (size_t k = 0; k < nbRetards; ++k) sortie[k] = produitScalaireScalaire(ref, cible + k, n);
+    }
+
+#ifdef SYNCHRO_X86
+    // --- SSE2 (toujours disponible en x86-64) ---------------------------------------------------
+
+    float sommeHorizontale(__m128 v) {
+        const __m128 hautBas = _mm_add_ps(v, _mm_movehl_ps(v, v));
+        return _mm_cvtss_f32(_mm_add_ss(hautBas, _mm_shuffle_ps(hautBas, hautBas, 1)));
+    }
+
+    double produitScalaireSSE(const float *a, const float *b, size_t n) {
+        double somme = 0.0;
+        size_t i = 0;
+
+        while (n - i >= 4) {
+            const size_t fin = min(n, i + TAILLE_BLOC);
+            __m128 acc0 = _mm_setzero_ps();
+            __m128 acc1 = _mm_setzero_ps();
+
+            for (; i + 8 <= fin; i += 8) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+                acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+            }
+            for (; i + 4 <= fin; i += 4) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            }
+
+            somme += sommeHorizontale(_mm_add_ps(acc0, acc1));
+        }
+
+        for (; i < n; ++i) somme += static_cast<double>(a[i]) * b[i];
+        return somme;
+    }
+
+    void correlationGlissanteSSE(const float *ref, const float *cible, size_t n, size_t nbRetards,
+                                 double *sortie) {
+        for (size_t k = 0; k < nbRetards; ++k) sortie[k] = produitScalaireSSE(ref, cible + k, n);
+    }
+
+    // --- AVX2 + FMA -----------------------------------------------------------------------------
+
+    CIBLE_AVX2 float sommeHorizontale(__m256 v) {
+        return sommeHorizontale(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+    }
+
+    CIBLE_AVX2 double produitScalaireAVX2(const float *a, const float *b, size_t n) {
+        double somme = 0.0;
+        size_t i = 0;
+
+        while (n - i >= 8) {
+            const size_t fin = min(n, i + TAILLE_BLOC);
+            __m256 acc0 = _mm256_setzero_ps();
+            __m256 acc1 = _mm256_setzero_ps();
+
+            for (; i + 16 <= fin; i += 16) {
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+                acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+            }
+            for (; i + 8 <= fin; i += 8) {
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+            }
+
+            somme += sommeHorizontale(_mm256_add_ps(acc0, acc1));
+        }
+
+        for (; i < n; ++i) somme += static_cast<double>(a[i]) * b[i];
+        return somme;
+    }
+
+    CIBLE_AVX2 void correlationGlissanteAVX2(const float *ref, const float *cible, size_t n, size_t nbRetards,
+                                             double *sortie) {
+        size_t k = 0;
+
+        // Quatre retards consécutifs par passe : chaque vecteur de référence est chargé une seule fois.
+        for (; k + RETARDS_PAR_PASSE <= nbRetards; k += RETARDS_PAR_PASSE) {
+            const float *c = cible + k;
+            double sommes[RETARDS_PAR_PASSE] = {};
+            size_t i = 0;
+
+            while (n - i >= 8) {
+                const size_t fin = min(n, i + TAILLE_BLOC);
+                __m256 acc0 = _mm256_setzero_ps();
+                __m256 acc1 = _mm256_setzero_ps();
+                __m256 acc2 = _mm256_setzero_ps();
+                __m256 acc3 = _mm256_setzero_ps();
+
+                for (; i + 8 <= fin; i += 8) {
+                    const __m256 r = _mm256_loadu_ps(ref + i);
+                    acc0 = _mm256_fmadd_ps(r, _mm256_loadu_ps(c + i), acc0);
+                    acc1 = _mm256_fmadd_ps(r, _mm256_loadu_ps(c + i + 1), acc1);
+                    acc2 = _mm256_fmadd_ps(r, _mm256_loadu_ps(c + i + 2), acc2);
+                    acc3 = _mm256_fmadd_ps(r, _mm256_loadu_ps(c + i + 3), acc3);
+                }
+
+                sommes[0] += sommeHorizontale(acc0);
+                sommes[1] += sommeHorizontale(acc1);
+                sommes[2] += sommeHorizontale(acc2);
+                sommes[3] += sommeHorizontale(acc3);
+            }
+
+            for (; i < n; ++i) {
+                for (size_t j = 0; j < RETARDS_PAR_PASSE; ++j) sommes[j] += static_cast<double>(ref[i]) * c[i + j];
+            }
+
+            copy_n(sommes, RETARDS_PAR_PASSE, sortie + k);
+        }
+
+        for (; k < nbRetards; ++k) sortie[k] = produitScalaireAVX2(ref, cible + k, n);
+    }
+
+    // --- AVX-512 --------------------------------------------------------------------------------
+
+    CIBLE_AVX512 double produitScalaireAVX512(const float *a, const float *b, size_t n) {
+        double somme = 0.0;
+        size_t i = 0;
+
+        while (n - i >= 16) {
+            const size_t fin = min(n, i + TAILLE_BLOC);
+            __m512 acc0 = _mm512_setzero_ps();
+            __m512 acc1 = _mm512_setzero_ps();
+
+            for (; i + 32 <= fin; i += 32) {
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+                acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), acc1);
+            }
+            for (; i + 16 <= fin; i += 16) {
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+            }
+
+            somme += _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+        }
+
+        for (; i < n; ++i) somme += static_cast<double>(a[i]) * b[i];
+        return somme;
+    }
+
+    CIBLE_AVX512 void correlationGlissanteAVX512(const float *ref, const float *cible, size_t n, size_t nbRetards,
+                                                 double *sortie) {
+        size_t k = 0;
+
+        for (; k + RETARDS_PAR_PASSE <= nbRetards; k += RETARDS_PAR_PASSE) {
+            const float *c = cible + k;
+            double sommes[RETARDS_PAR_PASSE] = {};
+            size_t i = 0;
+
+            while (n - i >= 16) {
+                const size_t fin = min(n, i + TAILLE_BLOC);
+                __m512 acc0 = _mm512_setzero_ps();
+                __m512 acc1 = _mm512_setzero_ps();
+                __m512 acc2 = _mm512_setzero_ps();
+                __m512 acc3 = _mm512_setzero_ps();
+
+                for (; i + 16 <= fin; i += 16) {
+                    const __m512 r = _mm512_loadu_ps(ref + i);
+                    acc0 = _mm512_fmadd_ps(r, _mm512_loadu_ps(c + i), acc0);
+                    acc1 = _mm512_fmadd_ps(r, _mm512_loadu_ps(c + i + 1), acc1);
+                    acc2 = _mm512_fmadd_ps(r, _mm512_loadu_ps(c + i + 2), acc2);
+                    acc3 = _mm512_fmadd_ps(r, _mm512_loadu_ps(c + i + 3), acc3);
+                }
+
+                sommes[0] += _mm512_reduce_add_ps(acc0);
+                sommes[1] += _mm512_reduce_add_ps(acc1);
+                sommes[2] += _mm512_reduce_add_ps(acc2);
+                sommes[3] += _mm512_reduce_add_ps(acc3);
+            }
+
+            for (; i < n; ++i) {
+                for (size_t j = 0; j < RETARDS_PAR_PASSE; ++j) sommes[j] += static_cast<double>(ref[i]) * c[i + j];
+            }
+
+            copy_n(sommes, RETARDS_PAR_PASSE, sortie + k);
+        }
+
+        for (; k < nbRetards; ++k) sortie[k] = produitScalaireAVX512(ref, cible + k, n);
+    }
+
+    // --- Détection du processeur ----------------------------------------------------------------
+
+    bool supporteAVX2() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER)
+        int registres[4];
+        __cpuid(registres, 1);
+        const bool fma = registres[2] & (1 << 12);
+        const bool avxSysteme = (registres[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+        __cpuidex(registres, 7, 0);
+        return fma && avxSysteme && (registres[1] & (1 << 5));
+#else
+        return false;
+#endif
+    }
+
+    bool supporteAVX512() {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER)
+        int registres[4];
+        __cpuid(registres, 1);
+        const bool etatsSauvegardes = (registres[2] & (1 << 27)) && (_xgetbv(0) & 0xE6) == 0xE6;
+        __cpuidex(registres, 7, 0);
+        return etatsSauvegardes && (registres[1] & (1 << 16));
+#else
+        return false;
+#endif
+    }
+#endif
+
+    NoyauxCorrelation detecterNoyaux() {
+#ifdef SYNCHRO_X86
+        if (supporteAVX512()) return {"AVX-512", produitScalaireAVX512, correlationGlissanteAVX512};
+        if (supporteAVX2()) return {"AVX2", produitScalaireAVX2, correlationGlissanteAVX2};
+        return {"SSE2", produitScalaireSSE, correlationGlissanteSSE};
+#else
+        return {"Scalaire", produitScalaireScalaire, correlationGlissanteScalaire};
+#endif
+    }
+}
+
+const NoyauxCorrelation &NoyauxCorrelation::obtenir() {
+    // Initialisation unique et thread-safe au premier appel.
+    static const NoyauxCorrelation noyaux = detecterNoyaux();
+    return noyaux;
+}
+
+void NoyauxCorrelation::correler(span<const float> ref, span<const float> cible, ptrdiff_t retardMin,
+                                 ptrdiff_t retardMax, vector<double> &sortie) const {
+    sortie.assign(retardMax >= retardMin ? retardMax - retardMin + 1 : 0, 0.0);
+
+    if (sortie.empty() || ref.empty() || cible.empty()) return;
+
+    Metriques::compterCorrelation(static_cast<int64_t>(ref.size()), static_cast<int64_t>(sortie.size()));
+
+    const auto tailleRef = static_cast<ptrdiff_t>(ref.size());
+    const auto tailleCible = static_cast<ptrdiff_t>(cible.size());
+
+    // Retards pour lesquels toute la référence tombe dans la cible : aucun contrôle de bornes nécessaire.
+    const ptrdiff_t debutPlein = max<ptrdiff_t>(retardMin, 0);
+    const ptrdiff_t finPlein = min(retardMax, tailleCible - tailleRef);
+
+    if (finPlein >= debutPlein) {
+        correlationGlissante(ref.data(), cible.data() + debutPlein, ref.size(), finPlein - debutPlein + 1,
+                             sortie.data() + (debutPlein - retardMin));
+    }
+
+    // Retards de bord : produit scalaire sur la seule partie commune.
+    for (ptrdiff_t k = retardMin; k <= retardMax; ++k) {
+        if (k >= debutPlein && k <= finPlein) {
+            k = finPlein;
+            continue;
+        }
+
+        const ptrdiff_t debut = max<ptrdiff_t>(0, -k);
+        const ptrdiff_t fin = min(tailleRef, tailleCible - k);
+
+        if (fin > debut) sortie[k - retardMin] = produitScalaire(ref.data() + debut, cible.data() + debut + k, fin - debut);
+    }
+}
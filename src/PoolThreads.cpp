@@ -0,0 +1,120 @@
+/**
+ * @file PoolThreads.cpp
+ * @brief Implémentation du pool de threads à vol de tâches utilisé par l'analyse parallèle et le traitement par lots.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/PoolThreads.h"
+
+#include <algorithm>
+
+using namespace std;
+
+thread_local PoolThreads *PoolThreads::poolCourant = nullptr;
+
+thread_local size_t PoolThreads::indiceCourant = 0;
+
+PoolThreads::PoolThreads(size_t nombre) {
+    if (nombre == 0) nombre = max(1u, thread::hardware_concurrency());
+
+    // Toutes les files existent avant le premier thread : un voleur peut les parcourir sans verrou global.
+    filesLocales.reserve(nombre);
+    for (size_t i = 0; i < nombre; ++i) filesLocales.push_back(make_unique<FileLocale>());
+
+    travailleurs.reserve(nombre);
+    for (size_t i = 0; i < nombre; ++i) {
+        travailleurs.emplace_back(&PoolThreads::executer, this, i);
+    }
+}
+
+PoolThreads::~PoolThreads() {
+    {
+        lock_guard verrouillage(verrou);
+        arret = true;
+    }
+
+    condition.notify_all();
+
+    for (auto &travailleur: travailleurs) travailleur.join();
+}
+
+size_t PoolThreads::obtenirTaille() const {
+    return travailleurs.size();
+}
+
+void PoolThreads::deposer(Tache tache, int priorite) {
+    const bool sousTache = poolCourant == this;
+
+    // Le compteur est incrémenté avant le dépôt : un thread qui prend la tâche ne le fait jamais passer sous zéro.
+    {
+        lock_guard verrouillage(verrou);
+        if (!sousTache) taches.emplace(make_pair(-priorite, numeroSoumission++), std::move(tache));
+        ++enAttente;
+    }
+
+    if (sousTache) {
+        FileLocale &file = *filesLocales[indiceCourant];
+        lock_guard verrouillage(file.verrou);
+        file.taches.push_back(std::move(tache));
+    }
+
+    condition.notify_one();
+}
+
+bool PoolThreads::prendre(size_t indice, bool commune, Tache &tache) {
+    // Sa propre file d'abord, par la fin : la sous-tâche la plus récente a ses données encore en cache.
+    {
+        FileLocale &file = *filesLocales[indice];
+        lock_guard verrouillage(file.verrou);
+
+        if (!file.taches.empty()) {
+            tache = std::move(file.taches.back());
+            file.taches.pop_back();
+        }
+    }
+
+    if (!tache && commune) {
+        lock_guard verrouillage(verrou);
+
+        if (!taches.empty()) {
+            tache = std::move(taches.begin()->second);
+            taches.erase(taches.begin());
+        }
+    }
+
+    // Vol de la plus ancienne sous-tâche des autres threads, en commençant par le voisin.
+    for (size_t k = 1; !tache && k < filesLocales.size(); ++k) {
+        FileLocale &file = *filesLocales[(indice + k) % filesLocales.size()];
+        lock_guard verrouillage(file.verrou);
+
+        if (!file.taches.empty()) {
+            tache = std::move(file.taches.front());
+            file.taches.pop_front();
+        }
+    }
+
+    if (!tache) return false;
+
+    lock_guard verrouillage(verrou);
+    --enAttente;
+    return true;
+}
+
+void PoolThreads::executer(size_t indice) {
+    poolCourant = this;
+    indiceCourant = indice;
+
+    while (true) {
+        Tache tache;
+
+        if (prendre(indice, true, tache)) {
+            tache();
+            continue;
+        }
+
+        unique_lock verrouillage(verrou);
+        condition.wait(verrouillage, [this] { return arret || enAttente > 0; });
+
+        // Les tâches restantes sont terminées avant l'arrêt.
+        if (arret && enAttente == 0) return;
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file ProfilEncodage.cpp
+ * @brief Profils d'encodage prédéfinis.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/ProfilEncodage.h"
+
+using namespace std;
+
+ProfilEncodage ProfilEncodage::apercu() {
+    ProfilEncodage profil;
+    profil.nom = "apercu";
+    profil.preset = "ultrafast";
+    profil.reglage = "zerolatency";
+    profil.profil = "baseline";
+    profil.crf = 30;
+    profil.tailleGOP = 30;
+    profil.parallelisme = Parallelisme::Tranches;
+    profil.echelle = 0.5;
+    profil.imagesParSeconde = 15;
+    return profil;
+}
+
+ProfilEncodage ProfilEncodage::equilibre() {
+    return ProfilEncodage();
+}
+
+ProfilEncodage ProfilEncodage::archive() {
+    ProfilEncodage profil;
+    profil.nom = "archive";
+    profil.preset = "slow";
+    profil.reglage = "";
+    profil.profil = "high";
+    profil.crf = 18;
+    profil.tailleGOP = 250;
+    profil.decodageReduit = false;
+    return profil;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file RecopieAudio.cpp
+ * @brief Implémentation de la recopie audio via libavformat.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/RecopieAudio.h"
+
+#include <cmath>
+#include <stdexcept>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/error.h>
+}
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Construit un message d'erreur lisible à partir d'un code d'erreur FFmpeg.
+     */
+    string messageErreur(const string &contexte, int code) {
+        char description[256];
+        av_strerror(code, description, sizeof(description));
+        return contexte + " (" + description + ")";
+    }
+}
+
+RecopieAudio::RecopieAudio(const string &fichier, double debutLecture, double delai)
+    : debutLecture(debutLecture), delai(delai) {
+    try {
+        int code = avformat_open_input(&entree, fichier.c_str(), nullptr, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir : " + fichier, code));
+
+        code = avformat_find_stream_info(entree, nullptr);
+        if (code < 0) throw runtime_error(messageErreur("Flux illisibles : " + fichier, code));
+
+        index = av_find_best_stream(entree, AVMEDIA_TYPE_AUDIO, -1, -1, nullptr, 0);
+        if (index < 0) throw runtime_error("Aucune piste audio dans : " + fichier);
+
+        for (unsigned int i = 0; i < entree->nb_streams; ++i) {
+            if (static_cast<int>(i) != index) entree->streams[i]->discard = AVDISCARD_ALL;
+        }
+
+        if (debutLecture > 0.0) {
+            const AVStream *source = entree->streams[index];
+            const int64_t debutFlux = source->start_time != AV_NOPTS_VALUE ? source->start_time : 0;
+            const int64_t horodatage = debutFlux + av_rescale_q(llround(debutLecture * AV_TIME_BASE),
+                                                                AV_TIME_BASE_Q, source->time_base);
+
+            code = av_seek_frame(entree, index, horodatage, AVSEEK_FLAG_BACKWARD);
+            if (code < 0) throw runtime_error(messageErreur("Déplacement impossible dans l'audio", code));
+        }
+
+        paquet = av_packet_alloc();
+        if (!paquet) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+    } catch (...) {
+        liberer();
+        throw;
+    }
+}
+
+RecopieAudio::~RecopieAudio() {
+    liberer();
+}
+
+void RecopieAudio::liberer() {
+    av_packet_free(&paquet);
+    avformat_close_input(&entree);
+}
+
+void RecopieAudio::ajouterFlux(AVFormatContext *sortie) {
+    const AVStream *source = entree->streams[index];
+
+    flux = avformat_new_stream(sortie, nullptr);
+    if (!flux) throw runtime_error("Création du flux audio impossible.");
+
+    avcodec_parameters_copy(flux->codecpar, source->codecpar);
+    flux->codecpar->codec_tag = 0;
+    flux->time_base = source->time_base;
+}
+
+void RecopieAudio::recopier(AVFormatContext *sortie, double jusqua, double fin) {
+    if (index < 0) return;
+
+    const AVStream *source = entree->streams[index];
+    const int64_t debutFlux = source->start_time != AV_NOPTS_VALUE ? source->start_time : 0;
+
+    // Décalage des horodatages : instant de sortie = instant source - debutLecture + delai.
+    const int64_t decalage = llround((delai - debutLecture) / av_q2d(source->time_base)) - debutFlux;
+
+    while (true) {
+        if (!enAttente) {
+            const int code = av_read_frame(entree, paquet);
+
+            if (code == AVERROR_EOF) {
+                index = -1;
+                return;
+            }
+
+            if (code < 0) throw runtime_error(messageErreur("Erreur de lecture de l'audio", code));
+
+            if (paquet->stream_index != index || paquet->pts == AV_NOPTS_VALUE) {
+                av_packet_unref(paquet);
+                continue;
+            }
+
+            enAttente = true;
+        }
+
+        const double instant = (paquet->pts + decalage) * av_q2d(source->time_base);
+
+        // Le paquet sera écrit avec une image ultérieure.
+        if (instant > jusqua) return;
+
+        enAttente = false;
+
+        if (instant >= fin) {
+            av_packet_unref(paquet);
+            index = -1;
+            return;
+        }
+
+        // Les paquets antérieurs au zéro commun (lus depuis l'image clé précédente) sont écartés.
+        if (instant < 0.0) {
+            av_packet_unref(paquet);
+            continue;
+        }
+
+        paquet->pts += decalage;
+        if (paquet->dts != AV_NOPTS_VALUE) paquet->dts += decalage;
+
+        av_packet_rescale_ts(paquet, source->time_base, flux->time_base);
+        paquet->stream_index = flux->index;
+        paquet->pos = -1;
+
+        const int code = av_interleaved_write_frame(sortie, paquet);
+        if (code < 0) throw runtime_error(messageErreur("Erreur d'écriture audio", code));
+    }
+}
@@ -0,0 +1,375 @@
+/**
+ * @file RenduMosaique.cpp
+ * @brief Implémentation du rendu de la mosaïque via libavformat, libavcodec et libswscale.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/RenduMosaique.h"
+#include "../include/ClassSynchroniseurMultiVideo/ArenaImages.h"
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurVideo.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+#include "../include/ClassSynchroniseurMultiVideo/PoolThreads.h"
+#include "../include/ClassSynchroniseurMultiVideo/RecopieAudio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/error.h>
+#include <libswscale/swscale.h>
+}
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Construit un message d'erreur lisible à partir d'un code d'erreur FFmpeg.
+     */
+    string messageErreur(const string &contexte, int code) {
+        char description[256];
+        av_strerror(code, description, sizeof(description));
+        return contexte + " (" + description + ")";
+    }
+
+    /**
+     * @brief Peint en noir une région YUV 4:2:0 (luminance 16, chrominance 128).
+     */
+    void peindreNoir(uint8_t *const plans[3], const int pas[3], int largeur, int hauteur) {
+        for (int y = 0; y < hauteur; ++y) memset(plans[0] + static_cast<ptrdiff_t>(y) * pas[0], 16, largeur);
+
+        for (int p = 1; p < 3; ++p) {
+            for (int y = 0; y < hauteur / 2; ++y) {
+                memset(plans[p] + static_cast<ptrdiff_t>(y) * pas[p], 128, largeur / 2);
+            }
+        }
+    }
+
+    int64_t nanosDepuis(chrono::steady_clock::time_point debut) {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - debut).count();
+    }
+}
+
+RenduMosaique::RenduMosaique(const vector<Entree> &entrees, int largeurTuile, int hauteurTuile,
+                             const ProfilEncodage &profil)
+    : entrees(entrees), largeurTuile(largeurTuile), hauteurTuile(hauteurTuile),
+      profil(profil) {
+    if (entrees.empty()) throw invalid_argument("Aucune vidéo à assembler.");
+
+    // Grille la plus carrée possible, comme pour la ligne de commande xstack.
+    colonnes = static_cast<int>(ceil(sqrt(static_cast<double>(entrees.size()))));
+    lignes = static_cast<int>((entrees.size() + colonnes - 1) / colonnes);
+}
+
+RenduMosaique::~RenduMosaique() {
+    liberer();
+}
+
+void RenduMosaique::liberer() {
+    av_packet_free(&paquet);
+
+    // L'encodeur peut encore référencer des images de l'arène : il est libéré avant elle.
+    avcodec_free_context(&encodeur);
+
+    emplacements.clear();
+    arene.reset();
+    audio.reset();
+
+    if (sortie && !(sortie->oformat->flags & AVFMT_NOFILE)) avio_closep(&sortie->pb);
+    avformat_free_context(sortie);
+    sortie = nullptr;
+}
+
+void RenduMosaique::configurerAudio(const string &fichier, double debutLecture, double delai) {
+    fichierAudio = fichier;
+    debutAudio = debutLecture;
+    delaiAudio = delai;
+}
+
+void RenduMosaique::configurerMetriques(Metriques *metriques) {
+    this->metriques = metriques;
+}
+
+void RenduMosaique::configurerThreads(int nombre) {
+    coeurs = max(0, nombre);
+}
+
+void RenduMosaique::ouvrirSortie(const string &fichierSortie) {
+    int code = avformat_alloc_output_context2(&sortie, nullptr, nullptr, fichierSortie.c_str());
+    if (code < 0 || !sortie) throw runtime_error(messageErreur("Format de sortie inconnu : " + fichierSortie, code));
+
+    const AVCodec *codec = avcodec_find_encoder_by_name("libx264");
+    if (!codec) codec = avcodec_find_encoder(AV_CODEC_ID_H264);
+    if (!codec) throw runtime_error("Aucun encodeur H.264 disponible.");
+
+    encodeur = avcodec_alloc_context3(codec);
+    if (!encodeur) throw runtime_error("Allocation de l'encodeur impossible.");
+
+    encodeur->width = colonnes * largeurTuile;
+    encodeur->height = lignes * hauteurTuile;
+    encodeur->pix_fmt = AV_PIX_FMT_YUV420P;
+    encodeur->time_base = {1, profil.imagesParSeconde};
+    encodeur->framerate = {profil.imagesParSeconde, 1};
+    encodeur->gop_size = profil.tailleGOP;
+    encodeur->thread_count = profil.threads > 0 ? profil.threads : coeurs;
+    encodeur->thread_type = profil.parallelisme == ProfilEncodage::Parallelisme::Tranches
+                                ? FF_THREAD_SLICE
+                                : FF_THREAD_FRAME;
+
+    if (profil.debitBinaire > 0) encodeur->bit_rate = static_cast<int64_t>(profil.debitBinaire) * 1000;
+
+    if (sortie->oformat->flags & AVFMT_GLOBALHEADER) encodeur->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+
+    AVDictionary *options = nullptr;
+    av_dict_set(&options, "preset", profil.preset.c_str(), 0);
+    av_dict_set(&options, "profile", profil.profil.c_str(), 0);
+    if (!profil.reglage.empty()) av_dict_set(&options, "tune", profil.reglage.c_str(), 0);
+    if (profil.debitBinaire <= 0) av_dict_set(&options, "crf", to_string(profil.crf).c_str(), 0);
+
+    code = avcodec_open2(encodeur, codec, &options);
+    av_dict_free(&options);
+    if (code < 0) throw runtime_error(messageErreur("Ouverture de l'encodeur impossible", code));
+
+    fluxVideo = avformat_new_stream(sortie, nullptr);
+    if (!fluxVideo) throw runtime_error("Création du flux vidéo impossible.");
+
+    avcodec_parameters_from_context(fluxVideo->codecpar, encodeur);
+    fluxVideo->time_base = encodeur->time_base;
+
+    // L'audio est recopié sans réencodage.
+    if (!fichierAudio.empty()) {
+        audio = make_unique<RecopieAudio>(fichierAudio, debutAudio, delaiAudio);
+        audio->ajouterFlux(sortie);
+    }
+
+    if (!(sortie->oformat->flags & AVFMT_NOFILE)) {
+        code = avio_open(&sortie->pb, fichierSortie.c_str(), AVIO_FLAG_WRITE);
+        if (code < 0) throw runtime_error(messageErreur("Impossible d'écrire : " + fichierSortie, code));
+    }
+
+    // Métadonnées en début de fichier, comme avec -movflags +faststart.
+    AVDictionary *optionsSortie = nullptr;
+    av_dict_set(&optionsSortie, "movflags", "+faststart", 0);
+    code = avformat_write_header(sortie, &optionsSortie);
+    av_dict_free(&optionsSortie);
+    if (code < 0) throw runtime_error(messageErreur("Écriture de l'en-tête impossible", code));
+
+    paquet = av_packet_alloc();
+    if (!paquet) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+}
+
+void RenduMosaique::encoder(const AVFrame *image) {
+    int code = avcodec_send_frame(encodeur, image);
+    if (code < 0) throw runtime_error(messageErreur("Erreur d'encodage vidéo", code));
+
+    while (true) {
+        code = avcodec_receive_packet(encodeur, paquet);
+        if (code == AVERROR(EAGAIN) || code == AVERROR_EOF) return;
+        if (code < 0) throw runtime_error(messageErreur("Erreur d'encodage vidéo", code));
+
+        av_packet_rescale_ts(paquet, encodeur->time_base, fluxVideo->time_base);
+        paquet->stream_index = fluxVideo->index;
+
+        code = av_interleaved_write_frame(sortie, paquet);
+        if (code < 0) throw runtime_error(messageErreur("Erreur d'écriture", code));
+    }
+}
+
+void RenduMosaique::preparerEmplacement(Emplacement &emplacement, int64_t numero) {
+    // L'image précédente retourne à l'arène ; si l'encodeur la référence encore, une autre est choisie.
+    // Les marges et les cases vides de la grille sont noires depuis la création de l'arène et ne sont
+    // jamais écrites ; les tuiles sont réécrites à chaque image.
+    if (emplacement.image) arene->rendre(emplacement.image);
+    AVFrame *image = arene->acquerir();
+
+    {
+        lock_guard verrouillage(verrou);
+        emplacement.image = image;
+        emplacement.numero = numero;
+        emplacement.tuilesRestantes = entrees.size();
+    }
+
+    condition.notify_all();
+}
+
+void RenduMosaique::composerEntree(size_t indice, int64_t nbImages, int threadsDecodeur) {
+    try {
+        const Entree &entree = entrees[indice];
+
+        Metriques::Etape etape(metriques, "rendu entree", entree.chemin);
+
+        // Seules la taille de la tuile et la cadence de sortie sont utiles : le décodeur peut réduire les deux.
+        const bool reduire = profil.decodageReduit;
+        DecodeurVideo decodeur(entree.chemin, threadsDecodeur, reduire ? largeurTuile : 0, reduire ? hauteurTuile : 0,
+                               reduire ? profil.imagesParSeconde : 0.0, profil.imagesBEcartees);
+        if (entree.debutLecture > 0.0) decodeur.chercher(entree.debutLecture);
+
+        unique_ptr<SwsContext, decltype(&sws_freeContext)> echelle(nullptr, sws_freeContext);
+
+        // Coin supérieur gauche de la tuile dans l'image de sortie.
+        const int x = static_cast<int>(indice % colonnes) * largeurTuile;
+        const int y = static_cast<int>(indice / colonnes) * hauteurTuile;
+
+        for (int64_t n = 0; n < nbImages; ++n) {
+            Emplacement &emplacement = emplacements[n % NOMBRE_EMPLACEMENTS];
+            AVFrame *image;
+
+            {
+                unique_lock verrouillage(verrou);
+                condition.wait(verrouillage, [&] { return abandon || emplacement.numero == n; });
+
+                if (abandon) return;
+
+                image = emplacement.image;
+            }
+
+            // La tuile est écrite en place, directement dans la région de l'image de sortie.
+            uint8_t *const tuile[3] = {
+                image->data[0] + static_cast<ptrdiff_t>(y) * image->linesize[0] + x,
+                image->data[1] + static_cast<ptrdiff_t>(y / 2) * image->linesize[1] + x / 2,
+                image->data[2] + static_cast<ptrdiff_t>(y / 2) * image->linesize[2] + x / 2
+            };
+
+            const double instant = static_cast<double>(n) / profil.imagesParSeconde - entree.delai;
+            const AVFrame *source = nullptr;
+
+            // Une horloge qui dérive est compensée en lisant le fichier à sa propre cadence.
+            if (instant >= 0.0 && instant * entree.vitesse < entree.duree) {
+                const auto debut = chrono::steady_clock::now();
+                source = decodeur.obtenirImage(entree.debutLecture + instant * entree.vitesse);
+                nanosDecodage += nanosDepuis(debut);
+            }
+
+            if (source) {
+                const auto debut = chrono::steady_clock::now();
+
+                // Une source au moins deux fois plus grande que la tuile est réduite par l'interpolation rapide.
+                const bool rapide = profil.decodageReduit && source->width >= 2 * largeurTuile
+                                    && source->height >= 2 * hauteurTuile;
+
+                echelle.reset(sws_getCachedContext(echelle.release(), source->width, source->height,
+                                                   static_cast<AVPixelFormat>(source->format), largeurTuile,
+                                                   hauteurTuile, AV_PIX_FMT_YUV420P,
+                                                   rapide ? SWS_FAST_BILINEAR : SWS_BICUBIC, nullptr, nullptr,
+                                                   nullptr));
+                if (!echelle) throw runtime_error("Mise à l'échelle impossible : " + entree.chemin);
+
+                sws_scale(echelle.get(), source->data, source->linesize, 0, source->height, tuile, image->linesize);
+
+                nanosMiseAEchelle += nanosDepuis(debut);
+            } else {
+                // Avant le début ou après la fin de l'entrée : tuile noire.
+                peindreNoir(tuile, image->linesize, largeurTuile, hauteurTuile);
+            }
+
+            {
+                lock_guard verrouillage(verrou);
+                --emplacement.tuilesRestantes;
+            }
+
+            condition.notify_all();
+        }
+    } catch (...) {
+        {
+            lock_guard verrouillage(verrou);
+            abandon = true;
+        }
+
+        condition.notify_all();
+        throw;
+    }
+}
+
+RenduMosaique::Statistiques RenduMosaique::generer(const string &fichierSortie, double duree) {
+    Metriques::Etape etape(metriques, "rendu", fichierSortie);
+
+    const auto debut = chrono::steady_clock::now();
+    int64_t nanosEncodage = 0;
+
+    const int64_t nbImages = max<int64_t>(1, llround(duree * profil.imagesParSeconde));
+
+    ouvrirSortie(fichierSortie);
+
+    // Toute la mémoire des images de sortie est allouée ici, une seule fois.
+    arene = make_unique<ArenaImages>(colonnes * largeurTuile, lignes * hauteurTuile,
+                                     NOMBRE_EMPLACEMENTS + RESERVE_IMAGES);
+    emplacements.resize(NOMBRE_EMPLACEMENTS);
+
+    for (int64_t n = 0; n < min<int64_t>(NOMBRE_EMPLACEMENTS, nbImages); ++n) {
+        preparerEmplacement(emplacements[n], n);
+    }
+
+    // Les cœurs sont partagés entre les décodeurs des entrées ; l'encodeur gère ses propres threads.
+    const int coeursDisponibles = coeurs > 0 ? coeurs : static_cast<int>(thread::hardware_concurrency());
+    const int threadsDecodeur = max(1, coeursDisponibles / static_cast<int>(entrees.size()));
+
+    {
+        // Un thread par entrée : chacun décode et compose sa tuile de toutes les images.
+        PoolThreads pool(entrees.size());
+        vector<future<void> > taches;
+
+        for (size_t i = 0; i < entrees.size(); ++i) {
+            taches.push_back(pool.soumettre([this, i, nbImages, threadsDecodeur] {
+                composerEntree(i, nbImages, threadsDecodeur);
+            }));
+        }
+
+        try {
+            for (int64_t n = 0; n < nbImages; ++n) {
+                Emplacement &emplacement = emplacements[n % NOMBRE_EMPLACEMENTS];
+
+                {
+                    unique_lock verrouillage(verrou);
+                    condition.wait(verrouillage, [&] { return abandon || emplacement.tuilesRestantes == 0; });
+
+                    if (abandon) break;
+                }
+
+                const auto debutEncodage = chrono::steady_clock::now();
+
+                emplacement.image->pts = n;
+                encoder(emplacement.image);
+                if (audio) audio->recopier(sortie, static_cast<double>(n + 1) / profil.imagesParSeconde, duree);
+
+                nanosEncodage += nanosDepuis(debutEncodage);
+
+                if (n + static_cast<int64_t>(NOMBRE_EMPLACEMENTS) < nbImages) {
+                    preparerEmplacement(emplacement, n + NOMBRE_EMPLACEMENTS);
+                }
+            }
+        } catch (...) {
+            {
+                lock_guard verrouillage(verrou);
+                abandon = true;
+            }
+
+            condition.notify_all();
+            throw;
+        }
+
+        // Propage l'erreur d'un thread d'entrée, le cas échéant.
+        for (auto &tache: taches) tache.get();
+    }
+
+    const auto debutEncodage = chrono::steady_clock::now();
+
+    encoder(nullptr);
+    if (audio) audio->recopier(sortie, duree, duree);
+
+    const int code = av_write_trailer(sortie);
+    if (code < 0) throw runtime_error(messageErreur("Finalisation du fichier impossible", code));
+
+    nanosEncodage += nanosDepuis(debutEncodage);
+
+    return {
+        nbImages,
+        nanosDepuis(debut) * 1e-9,
+        nanosDecodage * 1e-9,
+        nanosMiseAEchelle * 1e-9,
+        nanosEncodage * 1e-9
+    };
+}
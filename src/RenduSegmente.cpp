@@ -0,0 +1,321 @@
+/**
+ * @file RenduSegmente.cpp
+ * @brief Implémentation du rendu segmenté et de l'assemblage des segments via libavformat.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/RenduSegmente.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+#include "../include/ClassSynchroniseurMultiVideo/PoolThreads.h"
+#include "../include/ClassSynchroniseurMultiVideo/RecopieAudio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+extern "C" {
+#include <libavcodec/avcodec.h>
+#include <libavformat/avformat.h>
+#include <libavutil/error.h>
+}
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Construit un message d'erreur lisible à partir d'un code d'erreur FFmpeg.
+     */
+    string messageErreur(const string &contexte, int code) {
+        char description[256];
+        av_strerror(code, description, sizeof(description));
+        return contexte + " (" + description + ")";
+    }
+
+    /**
+     * @brief Replace une entrée sur la chronologie d'un segment commençant à l'instant debut de la sortie.
+     */
+    RenduMosaique::Entree decaler(const RenduMosaique::Entree &entree, double debut) {
+        RenduMosaique::Entree decalee = entree;
+
+        if (debut <= entree.delai) {
+            decalee.delai = entree.delai - debut;
+            return decalee;
+        }
+
+        // Le segment commence après la première image de l'entrée : la lecture est avancée d'autant.
+        const double avance = debut - entree.delai;
+        decalee.delai = 0.0;
+
+        if (avance * entree.vitesse < entree.duree) {
+            decalee.debutLecture += avance * entree.vitesse;
+            decalee.duree -= avance * entree.vitesse;
+        } else {
+            // L'entrée est déjà terminée : tuile noire sur tout le segment.
+            decalee.duree = 0.0;
+        }
+
+        return decalee;
+    }
+
+    /**
+     * @brief Chemins temporaires des segments, à côté du fichier de sortie.
+     *
+     * Le suffixe est propre au thread et à l'instant, et n'est retenu que si aucun des chemins n'existe :
+     * aucun fichier de l'utilisateur n'est écrasé puis supprimé.
+     */
+    vector<string> cheminsSegments(const string &fichierSortie, size_t nombre) {
+        const filesystem::path sortie(fichierSortie);
+
+        while (true) {
+            ostringstream suffixe;
+            suffixe << ".tmp" << this_thread::get_id() << "_" << chrono::steady_clock::now().time_since_epoch().count();
+
+            vector<string> chemins;
+            bool libres = true;
+
+            for (size_t k = 0; k < nombre && libres; ++k) {
+                const filesystem::path chemin = sortie.parent_path() / (sortie.stem().string() + suffixe.str()
+                                                                        + ".segment" + to_string(k) + ".mp4");
+                libres = !filesystem::exists(chemin);
+                chemins.push_back(chemin.string());
+            }
+
+            if (libres) return chemins;
+        }
+    }
+}
+
+RenduSegmente::RenduSegmente(const vector<RenduMosaique::Entree> &entrees, int largeurTuile, int hauteurTuile,
+                             const ProfilEncodage &profil, int nombreSegments)
+    : entrees(entrees), largeurTuile(largeurTuile), hauteurTuile(hauteurTuile), profil(profil),
+      nombreSegments(max(1, nombreSegments)) {
+    if (entrees.empty()) throw invalid_argument("Aucune vidéo à assembler.");
+}
+
+RenduSegmente::~RenduSegmente() {
+    liberer();
+}
+
+void RenduSegmente::liberer() {
+    av_packet_free(&paquet);
+    avformat_close_input(&segment);
+
+    if (sortie && !(sortie->oformat->flags & AVFMT_NOFILE)) avio_closep(&sortie->pb);
+    avformat_free_context(sortie);
+    sortie = nullptr;
+}
+
+void RenduSegmente::configurerMetriques(Metriques *metriques) {
+    this->metriques = metriques;
+}
+
+void RenduSegmente::configurerThreads(int nombre) {
+    coeurs = max(0, nombre);
+}
+
+void RenduSegmente::configurerAudio(const string &fichier, double debutLecture, double delai) {
+    fichierAudio = fichier;
+    debutAudio = debutLecture;
+    delaiAudio = delai;
+}
+
+int RenduSegmente::ouvrirSegment(const string &fichier) {
+    avformat_close_input(&segment);
+
+    int code = avformat_open_input(&segment, fichier.c_str(), nullptr, nullptr);
+    if (code < 0) throw runtime_error(messageErreur("Impossible d'ouvrir le segment : " + fichier, code));
+
+    code = avformat_find_stream_info(segment, nullptr);
+    if (code < 0) throw runtime_error(messageErreur("Segment illisible : " + fichier, code));
+
+    const int index = av_find_best_stream(segment, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (index < 0) throw runtime_error("Aucune piste vidéo dans le segment : " + fichier);
+
+    return index;
+}
+
+void RenduSegmente::assembler(const vector<string> &fichiers, const vector<int64_t> &debuts,
+                              const string &fichierSortie, double duree) {
+    Metriques::Etape etape(metriques, "assemblage", fichierSortie);
+
+    int code = avformat_alloc_output_context2(&sortie, nullptr, nullptr, fichierSortie.c_str());
+    if (code < 0 || !sortie) throw runtime_error(messageErreur("Format de sortie inconnu : " + fichierSortie, code));
+
+    // Les paramètres du flux (dont SPS et PPS) sont ceux du premier segment ; les suivants sont vérifiés.
+    int index = ouvrirSegment(fichiers[0]);
+
+    fluxVideo = avformat_new_stream(sortie, nullptr);
+    if (!fluxVideo) throw runtime_error("Création du flux vidéo impossible.");
+
+    avcodec_parameters_copy(fluxVideo->codecpar, segment->streams[index]->codecpar);
+    fluxVideo->codecpar->codec_tag = 0;
+    fluxVideo->time_base = {1, profil.imagesParSeconde};
+
+    // L'audio est recopié une seule fois, sur toute la durée.
+    unique_ptr<RecopieAudio> audio;
+    if (!fichierAudio.empty()) {
+        audio = make_unique<RecopieAudio>(fichierAudio, debutAudio, delaiAudio);
+        audio->ajouterFlux(sortie);
+    }
+
+    if (!(sortie->oformat->flags & AVFMT_NOFILE)) {
+        code = avio_open(&sortie->pb, fichierSortie.c_str(), AVIO_FLAG_WRITE);
+        if (code < 0) throw runtime_error(messageErreur("Impossible d'écrire : " + fichierSortie, code));
+    }
+
+    AVDictionary *optionsSortie = nullptr;
+    av_dict_set(&optionsSortie, "movflags", "+faststart", 0);
+    code = avformat_write_header(sortie, &optionsSortie);
+    av_dict_free(&optionsSortie);
+    if (code < 0) throw runtime_error(messageErreur("Écriture de l'en-tête impossible", code));
+
+    paquet = av_packet_alloc();
+    if (!paquet) throw runtime_error("Allocation des tampons FFmpeg impossible.");
+
+    const double dureeImage = 1.0 / profil.imagesParSeconde;
+
+    for (size_t k = 0; k < fichiers.size(); ++k) {
+        if (k > 0) {
+            index = ouvrirSegment(fichiers[k]);
+
+            // Des SPS/PPS différents rendraient le flux concaténé indécodable à partir de ce segment.
+            const AVCodecParameters *parametres = segment->streams[index]->codecpar;
+            const AVCodecParameters *reference = fluxVideo->codecpar;
+
+            if (parametres->codec_id != reference->codec_id || parametres->width != reference->width
+                || parametres->height != reference->height
+                || parametres->extradata_size != reference->extradata_size
+                || !equal(parametres->extradata, parametres->extradata + parametres->extradata_size,
+                          reference->extradata)) {
+                throw runtime_error("Paramètres du segment " + to_string(k) + " différents du premier : "
+                                    + fichiers[k]);
+            }
+        }
+
+        const AVRational baseSegment = segment->streams[index]->time_base;
+
+        // Chaque segment commence à 0 : ses paquets sont décalés de l'instant de début du segment.
+        const int64_t decalage = av_rescale_q(debuts[k], {1, profil.imagesParSeconde}, fluxVideo->time_base);
+
+        while (true) {
+            code = av_read_frame(segment, paquet);
+            if (code == AVERROR_EOF) break;
+            if (code < 0) throw runtime_error(messageErreur("Erreur de lecture du segment", code));
+
+            if (paquet->stream_index != index) {
+                av_packet_unref(paquet);
+                continue;
+            }
+
+            av_packet_rescale_ts(paquet, baseSegment, fluxVideo->time_base);
+            if (paquet->pts != AV_NOPTS_VALUE) paquet->pts += decalage;
+            if (paquet->dts != AV_NOPTS_VALUE) paquet->dts += decalage;
+            paquet->stream_index = fluxVideo->index;
+            paquet->pos = -1;
+
+            const int64_t horodatage = paquet->dts != AV_NOPTS_VALUE ? paquet->dts : paquet->pts;
+            const double instant = horodatage * av_q2d(fluxVideo->time_base);
+
+            code = av_interleaved_write_frame(sortie, paquet);
+            if (code < 0) throw runtime_error(messageErreur("Erreur d'écriture", code));
+
+            if (audio) audio->recopier(sortie, instant + dureeImage, duree);
+        }
+    }
+
+    if (audio) audio->recopier(sortie, duree, duree);
+
+    code = av_write_trailer(sortie);
+    if (code < 0) throw runtime_error(messageErreur("Finalisation du fichier impossible", code));
+
+    liberer();
+}
+
+RenduMosaique::Statistiques RenduSegmente::generer(const string &fichierSortie, double duree) {
+    const auto debut = chrono::steady_clock::now();
+
+    const int64_t nbImages = max<int64_t>(1, llround(duree * profil.imagesParSeconde));
+    const int64_t gop = max(1, profil.tailleGOP);
+
+    // Longueur commune des segments, arrondie au GOP supérieur : chaque segment commence sur une image clé
+    // de la cadence normale, et seul le dernier peut être plus court.
+    const int64_t parSegment = (nbImages + nombreSegments - 1) / nombreSegments;
+    const int64_t longueur = (parSegment + gop - 1) / gop * gop;
+
+    vector<int64_t> debuts;
+    for (int64_t n = 0; n < nbImages; n += longueur) debuts.push_back(n);
+
+    // Sortie trop courte pour être découpée : rendu direct.
+    if (debuts.size() < 2) {
+        RenduMosaique rendu(entrees, largeurTuile, hauteurTuile, profil);
+        rendu.configurerThreads(coeurs);
+        rendu.configurerMetriques(metriques);
+        if (!fichierAudio.empty()) rendu.configurerAudio(fichierAudio, debutAudio, delaiAudio);
+        return rendu.generer(fichierSortie, duree);
+    }
+
+    const vector<string> fichiers = cheminsSegments(fichierSortie, debuts.size());
+
+    const auto supprimerSegments = [&fichiers] {
+        error_code ignoree;
+        for (const string &fichier: fichiers) filesystem::remove(fichier, ignoree);
+    };
+
+    // Les cœurs sont répartis entre les segments : chaque encodeur reste dans la zone où il passe à l'échelle.
+    const int coeursDisponibles = coeurs > 0 ? coeurs : static_cast<int>(thread::hardware_concurrency());
+    const int coeursParSegment = max(1, coeursDisponibles / static_cast<int>(debuts.size()));
+
+    ProfilEncodage profilSegment = profil;
+    if (profilSegment.threads <= 0) profilSegment.threads = coeursParSegment;
+
+    RenduMosaique::Statistiques stats{nbImages, 0.0, 0.0, 0.0, 0.0};
+
+    try {
+        PoolThreads pool(debuts.size());
+        vector<future<RenduMosaique::Statistiques> > taches;
+
+        for (size_t k = 0; k < debuts.size(); ++k) {
+            taches.push_back(pool.soumettre([&, k] {
+                const double instantDebut = static_cast<double>(debuts[k]) / profil.imagesParSeconde;
+                const int64_t images = min(longueur, nbImages - debuts[k]);
+
+                vector<RenduMosaique::Entree> entreesSegment;
+                for (const auto &entree: entrees) entreesSegment.push_back(decaler(entree, instantDebut));
+
+                // Segments muets : l'audio est recopié à l'assemblage.
+                RenduMosaique rendu(entreesSegment, largeurTuile, hauteurTuile, profilSegment);
+                rendu.configurerThreads(coeursParSegment);
+                rendu.configurerMetriques(metriques);
+
+                return rendu.generer(fichiers[k], static_cast<double>(images) / profil.imagesParSeconde);
+            }));
+        }
+
+        for (auto &tache: taches) {
+            const RenduMosaique::Statistiques segment = tache.get();
+            stats.secondesDecodage += segment.secondesDecodage;
+            stats.secondesMiseAEchelle += segment.secondesMiseAEchelle;
+            stats.secondesEncodage += segment.secondesEncodage;
+        }
+    } catch (...) {
+        supprimerSegments();
+        throw;
+    }
+
+    try {
+        assembler(fichiers, debuts, fichierSortie, duree);
+    } catch (...) {
+        liberer();
+        supprimerSegments();
+        throw;
+    }
+
+    supprimerSegments();
+
+    stats.secondesTotal = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    return stats;
+}
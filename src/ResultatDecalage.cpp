@@ -0,0 +1,42 @@
+/**
+ * @file ResultatDecalage.cpp
+ * @brief Notation de la netteté d'un pic de corrélation.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/ResultatDecalage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+void ResultatDecalage::noterNettete(span<const double> courbe, size_t indicePic, size_t lobePrincipal) {
+    rapportPicLobes = 0.0;
+    margeSecondPic = 0.0;
+
+    if (indicePic >= courbe.size()) return;
+
+    const double pic = courbe[indicePic];
+
+    // Statistiques des lobes secondaires : tout le reste de la plage.
+    double somme = 0.0, sommeCarres = 0.0, second = -numeric_limits<double>::infinity();
+    size_t nbLobes = 0;
+
+    for (size_t k = 0; k < courbe.size(); ++k) {
+        if ((k > indicePic ? k - indicePic : indicePic - k) <= lobePrincipal) continue;
+
+        somme += courbe[k];
+        sommeCarres += courbe[k] * courbe[k];
+        second = max(second, courbe[k]);
+        ++nbLobes;
+    }
+
+    if (nbLobes < 2) return;
+
+    const double moyenne = somme / nbLobes;
+    const double ecartType = sqrt(max(0.0, sommeCarres / nbLobes - moyenne * moyenne));
+
+    if (ecartType > 0.0) rapportPicLobes = (pic - moyenne) / ecartType;
+    if (pic > 0.0) margeSecondPic = clamp((pic - second) / pic, 0.0, 1.0);
+}
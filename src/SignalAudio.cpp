@@ -0,0 +1,105 @@
+/**
+ * @file SignalAudio.cpp
+ * @brief Implémentation du signal audio possédé ou projeté en mémoire.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/SignalAudio.h"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+SignalAudio::SignalAudio(vector<float> &&echantillons) : echantillons(std::move(echantillons)) {
+    vue = this->echantillons;
+}
+
+SignalAudio SignalAudio::projeter(const string &fichier, size_t decalage, size_t nombre) {
+    SignalAudio signal;
+
+    if (nombre == 0) return signal;
+
+    const size_t taille = decalage + nombre * sizeof(float);
+
+#ifdef _WIN32
+    HANDLE descripteur = CreateFileA(fichier.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                     FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (descripteur == INVALID_HANDLE_VALUE) throw runtime_error("Impossible d'ouvrir : " + fichier);
+
+    HANDLE correspondance = CreateFileMappingA(descripteur, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(descripteur);
+    if (!correspondance) throw runtime_error("Projection impossible : " + fichier);
+
+    void *adresse = MapViewOfFile(correspondance, FILE_MAP_READ, 0, 0, taille);
+    CloseHandle(correspondance);
+    if (!adresse) throw runtime_error("Projection impossible : " + fichier);
+#else
+    const int descripteur = open(fichier.c_str(), O_RDONLY);
+    if (descripteur < 0) throw runtime_error("Impossible d'ouvrir : " + fichier);
+
+    void *adresse = mmap(nullptr, taille, PROT_READ, MAP_SHARED, descripteur, 0);
+    close(descripteur);
+    if (adresse == MAP_FAILED) throw runtime_error("Projection impossible : " + fichier);
+
+    // Les échantillons sont parcourus séquentiellement par la corrélation.
+    madvise(adresse, taille, MADV_SEQUENTIAL);
+#endif
+
+    signal.projection = adresse;
+    signal.tailleProjection = taille;
+    signal.vue = {reinterpret_cast<const float *>(static_cast<const char *>(adresse) + decalage), nombre};
+
+    return signal;
+}
+
+SignalAudio::~SignalAudio() {
+    liberer();
+}
+
+SignalAudio::SignalAudio(SignalAudio &&autre) noexcept {
+    *this = std::move(autre);
+}
+
+SignalAudio &SignalAudio::operator=(SignalAudio &&autre) noexcept {
+    if (this == &autre) return *this;
+
+    liberer();
+
+    // La vue d'un signal possédé doit suivre le déplacement du vecteur.
+    const bool possede = autre.projection == nullptr;
+
+    echantillons = std::move(autre.echantillons);
+    projection = exchange(autre.projection, nullptr);
+    tailleProjection = exchange(autre.tailleProjection, 0);
+    vue = possede ? span<const float>(echantillons) : autre.vue;
+    autre.vue = {};
+
+    return *this;
+}
+
+span<const float> SignalAudio::obtenirEchantillons() const {
+    return vue;
+}
+
+void SignalAudio::liberer() {
+    if (!projection) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(projection);
+#else
+    munmap(projection, tailleProjection);
+#endif
+
+    projection = nullptr;
+    tailleProjection = 0;
+    vue = {};
+}
@@ -0,0 +1,374 @@
+/**
+ * @file SuiviDirect.cpp
+ * @brief Implémentation du suivi en direct des décalages de sources en cours d'enregistrement.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/SuiviDirect.h"
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurAudio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    /**
+     * @brief Somme des carrés des échantillons.
+     */
+    double energie(span<const float> echantillons) {
+        double somme = 0.0;
+        for (const float v: echantillons) somme += static_cast<double>(v) * v;
+        return somme;
+    }
+}
+
+SuiviDirect::SuiviDirect(const string &fichierRef, const vector<string> &fichiersCibles, int frequence, double plage,
+                         double periode, double memoire, double plageSuivi, double seuil)
+    : frequence(frequence), plage(llround(plage * frequence)), plageSuivi(max(1ll, llround(plageSuivi * frequence))),
+      memoire(max(1ll, llround(memoire * frequence))), periode(periode), seuil(seuil),
+      tailleMorceau(max<size_t>(256, static_cast<size_t>(periode * frequence / 2))) {
+    // L'acquisition garde une fenêtre et ±plage de cible ; le suivi, ±plageSuivi et quelques morceaux en vol.
+    capacite = this->memoire + 2 * this->plage + 2 * this->plageSuivi + 4 * tailleMorceau;
+
+    entrees.push_back(make_unique<Entree>(fichierRef, capacite));
+    for (const string &fichier: fichiersCibles) entrees.push_back(make_unique<Entree>(fichier, capacite));
+
+    poursuites.resize(fichiersCibles.size());
+}
+
+SuiviDirect::~SuiviDirect() {
+    rejoindre();
+}
+
+void SuiviDirect::arreter() {
+    arret = true;
+
+    {
+        lock_guard verrouillage(verrouReveil);
+    }
+    reveil.notify_all();
+
+    for (const auto &entree: entrees) {
+        {
+            lock_guard verrouillage(entree->verrou);
+        }
+        entree->place.notify_all();
+    }
+}
+
+void SuiviDirect::rejoindre() {
+    arreter();
+
+    for (const auto &entree: entrees) {
+        if (entree->lecteur.joinable()) entree->lecteur.join();
+    }
+}
+
+void SuiviDirect::lire(Entree &entree) {
+    try {
+        // Le décodeur vit dans le thread : l'ouverture d'un tube nommé bloque jusqu'à l'arrivée de son écrivain.
+        DecodeurAudio decodeur(entree.chemin, frequence, true, &arret);
+
+        while (!arret) {
+            span<float> zone;
+
+            {
+                unique_lock verrouillage(entree.verrou);
+                TamponCirculaire &tampon = entree.tampon;
+
+                // Libère ce dont le suivi n'a plus besoin ; sans place pour un morceau, attend que la limite avance.
+                entree.place.wait(verrouillage, [&] {
+                    tampon.liberer(min(entree.limite, tampon.obtenirFin() + static_cast<int64_t>(tailleMorceau)
+                                                      - static_cast<int64_t>(capacite)));
+                    const auto occupe = static_cast<size_t>(tampon.obtenirFin() - tampon.obtenirDebut());
+                    return arret || capacite - occupe >= tailleMorceau;
+                });
+
+                if (arret) break;
+                zone = tampon.zoneEcriture();
+            }
+
+            // La zone libre n'est touchée que par ce thread : le décodage se fait hors du verrou.
+            zone = zone.first(min(zone.size(), tailleMorceau));
+            const size_t lus = decodeur.lire(zone);
+
+            {
+                lock_guard verrouillage(entree.verrou);
+                entree.tampon.valider(lus);
+            }
+
+            if (lus < zone.size()) break;
+        }
+    } catch (const exception &e) {
+        // Une source interrompue par l'arrêt n'est pas en erreur.
+        if (!arret) {
+            lock_guard verrouillage(entree.verrou);
+            entree.erreur = entree.chemin + " : " + e.what();
+        }
+    }
+
+    entree.termine = true;
+}
+
+SuiviDirect::Etat SuiviDirect::observer(Entree &entree) {
+    lock_guard verrouillage(entree.verrou);
+    return {entree.tampon.obtenirDebut(), entree.tampon.obtenirFin(), entree.termine.load()};
+}
+
+void SuiviDirect::extraire(Entree &entree, int64_t position, size_t taille, int64_t fin, vector<float> &sortie) {
+    sortie.resize(taille);
+
+    {
+        lock_guard verrouillage(entree.verrou);
+        entree.tampon.copier(position, sortie);
+    }
+
+    // Ce qui suit fin (reçu depuis le relevé, ou à corréler plus tard depuis l'autre côté) reste à zéro.
+    const int64_t garde = clamp<int64_t>(fin - position, 0, static_cast<int64_t>(taille));
+    fill(sortie.begin() + garde, sortie.end(), 0.0f);
+}
+
+bool SuiviDirect::acquerir(size_t indice, const Etat &etatRef, const Etat &etatCible, ResultatDecalage &resultat) {
+    Poursuite &poursuite = poursuites[indice];
+    Entree &ref = *entrees[0];
+    Entree &cible = *entrees[indice + 1];
+
+    if (etatRef.fin < poursuite.prochaineAcquisition) return false;
+
+    // Bloc de référence le plus récent dont toute la plage de cible est arrivée.
+    const int64_t finBloc = etatCible.termine ? etatRef.fin : min(etatRef.fin, etatCible.fin - plage);
+    const int64_t debutBloc = finBloc - memoire;
+
+    if (debutBloc < etatRef.debut) return false;
+
+    // Une tentative par quart de fenêtre : l'acquisition coûte une corrélation sur toute la plage.
+    poursuite.prochaineAcquisition = etatRef.fin + memoire / 4;
+
+    extraire(ref, debutBloc, memoire, etatRef.fin, bloc);
+    extraire(cible, debutBloc - plage, memoire + 2 * plage, etatCible.fin, segment);
+
+    vector<double> courbe;
+    correlateurAcquisition.correler(bloc, segment, 0, 2 * plage, courbe);
+
+    const auto indicePic = static_cast<size_t>(max_element(courbe.begin(), courbe.end()) - courbe.begin());
+    resultat.noterNettete(courbe, indicePic, max<size_t>(2, lround(DUREE_LOBE_PRINCIPAL * frequence)));
+
+    if (resultat.rapportPicLobes < seuil) return false;
+
+    // Le suivi est amorcé avec le bloc de l'acquisition, autour du retard trouvé.
+    const int64_t centre = static_cast<int64_t>(indicePic) - plage;
+    poursuite.retardMin = centre - plageSuivi;
+    poursuite.retardMax = centre + plageSuivi;
+    poursuite.correlateur = make_unique<CorrelateurIncremental>(poursuite.retardMin, poursuite.retardMax);
+
+    poursuite.traitesRef = finBloc;
+    poursuite.traitesCible = min(etatCible.fin, finBloc + poursuite.retardMax);
+
+    extraire(cible, debutBloc + poursuite.retardMin, memoire + 2 * plageSuivi, poursuite.traitesCible, segment);
+    poursuite.correlateur->accumuler(bloc, segment);
+
+    poursuite.energieRef = energie(bloc);
+    poursuite.energieCible = energie(span<const float>(segment).subspan(plageSuivi, memoire));
+
+    if (!evaluer(poursuite, resultat)) return false;
+
+    resultat.plageExploree = static_cast<double>(plage) / frequence;
+    return true;
+}
+
+bool SuiviDirect::poursuivre(size_t indice, const Etat &etatRef, const Etat &etatCible, ResultatDecalage &resultat) {
+    Poursuite &poursuite = poursuites[indice];
+    Entree &ref = *entrees[0];
+    Entree &cible = *entrees[indice + 1];
+
+    // Au plus une fenêtre par côté et par mise à jour : le rattrapage d'un retard reste borné.
+    const int64_t finRef = min(etatRef.fin, poursuite.traitesRef + memoire);
+    const int64_t finCible = min(etatCible.fin, poursuite.traitesCible + memoire);
+
+    // Après la fin d'une entrée, les échantillons de l'autre n'ont plus de partenaire : ils sont sautés.
+    const int64_t finRefUtile = etatCible.termine
+                                    ? clamp(etatCible.fin - poursuite.retardMin, poursuite.traitesRef, finRef)
+                                    : finRef;
+    const int64_t finCibleUtile = etatRef.termine
+                                      ? clamp(etatRef.fin + poursuite.retardMax, poursuite.traitesCible, finCible)
+                                      : finCible;
+
+    if (finRefUtile <= poursuite.traitesRef && finCibleUtile <= poursuite.traitesCible) {
+        poursuite.traitesRef = finRef;
+        poursuite.traitesCible = finCible;
+        return false;
+    }
+
+    // Oubli exponentiel : le suivi s'adapte à une dérive ou à un changement de décalage.
+    const int64_t nouveaux = max(finRefUtile - poursuite.traitesRef, finCibleUtile - poursuite.traitesCible);
+    const double facteur = exp(-static_cast<double>(nouveaux) / memoire);
+
+    poursuite.correlateur->attenuer(facteur);
+    poursuite.energieRef *= facteur;
+    poursuite.energieCible *= facteur;
+
+    const auto largeur = static_cast<size_t>(poursuite.retardMax - poursuite.retardMin);
+
+    // Nouvelle référence contre la cible déjà corrélée...
+    if (finRefUtile > poursuite.traitesRef) {
+        const auto n = static_cast<size_t>(finRefUtile - poursuite.traitesRef);
+
+        extraire(ref, poursuite.traitesRef, n, finRefUtile, bloc);
+        extraire(cible, poursuite.traitesRef + poursuite.retardMin, n + largeur, poursuite.traitesCible, segment);
+        poursuite.correlateur->accumuler(bloc, segment);
+
+        poursuite.energieRef += energie(bloc);
+    }
+
+    poursuite.traitesRef = finRef;
+
+    // ... puis nouvelle cible contre toute la référence corrélée : chaque paire n'est comptée qu'une fois.
+    if (finCibleUtile > poursuite.traitesCible) {
+        const auto n = static_cast<size_t>(finCibleUtile - poursuite.traitesCible);
+
+        extraire(cible, poursuite.traitesCible, n, finCibleUtile, bloc);
+        extraire(ref, poursuite.traitesCible - poursuite.retardMax, n + largeur, poursuite.traitesRef, segment);
+        poursuite.correlateur->accumulerCible(bloc, segment);
+
+        poursuite.energieCible += energie(bloc);
+    }
+
+    poursuite.traitesCible = finCible;
+
+    return evaluer(poursuite, resultat);
+}
+
+bool SuiviDirect::evaluer(Poursuite &poursuite, ResultatDecalage &resultat) {
+    const vector<double> &courbe = poursuite.correlateur->obtenirCorrelation();
+    const auto indicePic = static_cast<size_t>(max_element(courbe.begin(), courbe.end()) - courbe.begin());
+    const auto lobe = max<size_t>(2, lround(DUREE_LOBE_PRINCIPAL * frequence));
+
+    resultat.noterNettete(courbe, indicePic, lobe);
+
+    // Sommet de la parabole passant par le pic et ses deux voisins.
+    double fraction = 0.0;
+    if (indicePic > 0 && indicePic + 1 < courbe.size()) {
+        const double gauche = courbe[indicePic - 1], centre = courbe[indicePic], droite = courbe[indicePic + 1];
+        const double courbure = gauche - 2.0 * centre + droite;
+        if (courbure < 0.0) fraction = clamp(0.5 * (gauche - droite) / courbure, -0.5, 0.5);
+    }
+
+    const double norme = sqrt(poursuite.energieRef * poursuite.energieCible);
+
+    resultat.decalage = (poursuite.retardMin + static_cast<double>(indicePic) + fraction) / frequence;
+    resultat.confiance = norme > 0.0 ? clamp(courbe[indicePic] / norme, 0.0, 1.0) : 0.0;
+    resultat.plageExploree = static_cast<double>(plageSuivi) / frequence;
+
+    // Pic au bord de la plage suivie ou noyé dans les lobes : le décalage a changé, retour à l'acquisition.
+    if (indicePic < lobe || indicePic + lobe >= courbe.size() || resultat.rapportPicLobes < seuil / 2) {
+        poursuite.correlateur.reset();
+        poursuite.prochaineAcquisition = 0;
+        return false;
+    }
+
+    return true;
+}
+
+void SuiviDirect::fixerLimites(const vector<Etat> &etats) {
+    vector<int64_t> limites(entrees.size(), numeric_limits<int64_t>::max());
+    const Etat &etatRef = etats[0];
+
+    for (size_t i = 0; i < poursuites.size(); ++i) {
+        const Poursuite &poursuite = poursuites[i];
+        const Etat &etatCible = etats[i + 1];
+
+        int64_t besoinRef, besoinCible;
+
+        if (poursuite.correlateur) {
+            // Le prochain bloc de référence est corrélé à partir de traitesRef + retardMin dans la cible,
+            // le prochain bloc de cible à partir de traitesCible - retardMax dans la référence.
+            besoinRef = min(poursuite.traitesRef, poursuite.traitesCible - poursuite.retardMax);
+            besoinCible = min(poursuite.traitesCible, poursuite.traitesRef + poursuite.retardMin);
+        } else {
+            // L'acquisition corrèle une fenêtre de référence contre ±plage de cible autour d'elle.
+            besoinRef = etatCible.fin - plage - memoire;
+            besoinCible = etatRef.fin - memoire - plage;
+        }
+
+        // Une entrée terminée et entièrement corrélée ne retient plus l'autre.
+        const bool refEpuisee = etatRef.termine && (!poursuite.correlateur || poursuite.traitesRef >= etatRef.fin);
+        const bool cibleEpuisee = etatCible.termine
+                                  && (!poursuite.correlateur || poursuite.traitesCible >= etatCible.fin);
+
+        if (!cibleEpuisee) limites[0] = min(limites[0], besoinRef);
+
+        if (!refEpuisee) limites[i + 1] = besoinCible;
+        else if (poursuite.correlateur) limites[i + 1] = poursuite.traitesCible;
+    }
+
+    for (size_t i = 0; i < entrees.size(); ++i) {
+        {
+            lock_guard verrouillage(entrees[i]->verrou);
+            entrees[i]->limite = limites[i];
+        }
+        entrees[i]->place.notify_all();
+    }
+}
+
+void SuiviDirect::executer(const Rappel &rappel) {
+    for (const auto &entree: entrees) entree->lecteur = thread(&SuiviDirect::lire, this, ref(*entree));
+
+    try {
+        const auto intervalle = chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(periode));
+        auto echeance = chrono::steady_clock::now();
+        bool enRetard = false;
+
+        while (!arret) {
+            // En retard sur les lecteurs (rattrapage d'un fichier déjà écrit), les mises à jour s'enchaînent.
+            if (!enRetard) {
+                echeance = max(echeance + intervalle, chrono::steady_clock::now());
+                unique_lock verrouillage(verrouReveil);
+                reveil.wait_until(verrouillage, echeance, [this] { return arret.load(); });
+            }
+
+            if (arret) break;
+
+            // Relevé avant les mises à jour : les derniers échantillons d'une entrée terminée sont corrélés.
+            vector<Etat> etats;
+            for (const auto &entree: entrees) etats.push_back(observer(*entree));
+
+            // Sans référence, plus rien ne peut être mesuré.
+            if (etats[0].termine && etats[0].fin == 0) break;
+
+            const bool toutesTerminees = all_of(etats.begin(), etats.end(), [](const Etat &e) { return e.termine; });
+            enRetard = false;
+
+            for (size_t i = 0; i < poursuites.size() && !arret; ++i) {
+                ResultatDecalage resultat;
+
+                const bool publie = poursuites[i].correlateur
+                                        ? poursuivre(i, etats[0], etats[i + 1], resultat)
+                                        : acquerir(i, etats[0], etats[i + 1], resultat);
+
+                if (publie && !rappel(i, resultat)) arreter();
+
+                const Poursuite &poursuite = poursuites[i];
+                if (poursuite.correlateur && (poursuite.traitesRef < etats[0].fin
+                                              || poursuite.traitesCible < etats[i + 1].fin)) {
+                    enRetard = true;
+                }
+            }
+
+            fixerLimites(etats);
+
+            if (toutesTerminees && !enRetard) break;
+        }
+    } catch (...) {
+        rejoindre();
+        throw;
+    }
+
+    rejoindre();
+
+    for (const auto &entree: entrees) {
+        if (!entree->erreur.empty()) throw runtime_error("Suivi en direct interrompu : " + entree->erreur);
+    }
+}
@@ -3,14 +3,29 @@
  * @brief Implémentation de la classe SynchroniseurMultiVideo.
  *
  * Ce fichier contient le code source des méthodes de la classe SynchroniseurMultiVideo,
- * incluant l'extraction audio via FFmpeg, le chargement des données brutes,
+ * incluant le décodage audio en mémoire via les bibliothèques FFmpeg,
  * le calcul de corrélation croisée et la génération de la vidéo finale.
  */
 
 #include "../include/ClassSynchroniseurMultiVideo/SynchroniseurMultiVideo.h"
+#include "../include/ClassSynchroniseurMultiVideo/CacheAnalyse.h"
+#include "../include/ClassSynchroniseurMultiVideo/CorrelateurFFT.h"
+#include "../include/ClassSynchroniseurMultiVideo/CorrelateurIncremental.h"
+#include "../include/ClassSynchroniseurMultiVideo/Decimateur.h"
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurAudio.h"
+#include "../include/ClassSynchroniseurMultiVideo/DecodeurVideo.h"
+#include "../include/ClassSynchroniseurMultiVideo/EstimateurDerive.h"
+#include "../include/ClassSynchroniseurMultiVideo/FicheSynchro.h"
+#include "../include/ClassSynchroniseurMultiVideo/GrapheAlignement.h"
+#include "../include/ClassSynchroniseurMultiVideo/LecteurAudioFlux.h"
+#include "../include/ClassSynchroniseurMultiVideo/Metriques.h"
+#include "../include/ClassSynchroniseurMultiVideo/NoyauxCorrelation.h"
+#include "../include/ClassSynchroniseurMultiVideo/PoolThreads.h"
+#include "../include/ClassSynchroniseurMultiVideo/RenduMosaique.h"
+#include "../include/ClassSynchroniseurMultiVideo/RenduSegmente.h"
+#include "../include/ClassSynchroniseurMultiVideo/SuiviDirect.h"
 
 #include <iostream>
-#include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -18,125 +33,880 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <cmath>
+#include <limits>
+#include <optional>
 
 using namespace std;
 
-SynchroniseurMultiVideo::~SynchroniseurMultiVideo() {
-    remove(TEMP_AUDIO_REF.c_str());
-    remove(TEMP_AUDIO_CIBLE.c_str());
-}
-
-void SynchroniseurMultiVideo::configurerAnalyse(double duree, double plage, int pas) {
+void SynchroniseurMultiVideo::configurerAnalyse(double duree, double plage, int pas, optional<MethodeCorrelation> methode) {
     if (duree > 0) dureeAnalyse = duree;
     if (plage > 0) plageRechercheMax = plage;
     if (pas > 0) pasDePrecision = pas;
+    if (methode) methodeCorrelation = *methode;
 }
 
-void SynchroniseurMultiVideo::extraireAudio(const string &fichierVideo, const string &fichierAudioSortie) const {
-    stringstream cmd;
+void SynchroniseurMultiVideo::configurerParallelisme(unsigned int threads) {
+    nombreThreads = threads;
+}
+
+void SynchroniseurMultiVideo::configurerRechercheHierarchique(int frequence, int candidats) {
+    if (frequence > 0) frequenceGrossiere = min(frequence, FREQUENCE_ECHANTILLONNAGE);
+    if (candidats > 0) nombreCandidats = candidats;
+}
+
+void SynchroniseurMultiVideo::configurerRechercheProgressive(bool actif, double fenetre, double seuil) {
+    rechercheProgressive = actif;
+    if (fenetre > 0) fenetreInitiale = fenetre;
+    if (seuil > 0) seuilRapportPicLobes = seuil;
+}
+
+void SynchroniseurMultiVideo::configurerEmpreintes(int votes) {
+    if (votes > 0) votesMinimum = votes;
+}
+
+void SynchroniseurMultiVideo::configurerLectureFlux(size_t memoireMax, const vector<double> &debuts) {
+    memoireFlux = memoireMax;
+    if (!debuts.empty()) debutsFenetres = debuts;
+}
+
+void SynchroniseurMultiVideo::configurerCache(const string &dossier) {
+    dossierCache = dossier;
+}
+
+void SynchroniseurMultiVideo::configurerAlignementGlobal(bool actif, double confianceMin) {
+    alignementGlobal = actif;
+    if (confianceMin >= 0.0) confianceMinimale = confianceMin;
+}
+
+void SynchroniseurMultiVideo::configurerChronologie(bool recouvrement) {
+    recouvrementSeul = recouvrement;
+}
+
+void SynchroniseurMultiVideo::configurerDerive(bool actif, double dureeFenetre, double intervalle) {
+    suiviDerive = actif;
+    if (dureeFenetre > 0) dureeFenetreDerive = dureeFenetre;
+    if (intervalle > 0) intervalleDerive = intervalle;
+}
+
+void SynchroniseurMultiVideo::configurerMetriques(const string &fichierJSON, const string &fichierChrome) {
+    fichierMetriques = fichierJSON;
+    fichierTrace = fichierChrome;
+}
+
+void SynchroniseurMultiVideo::demarrerMetriques() const {
+    metriques = fichierMetriques.empty() && fichierTrace.empty() ? nullptr : make_shared<Metriques>();
+}
+
+void SynchroniseurMultiVideo::ecrireMetriques() const {
+    if (!metriques) return;
+
+    try {
+        if (!fichierMetriques.empty()) {
+            metriques->ecrireJSON(fichierMetriques);
+            cout << "[Métriques] " << fichierMetriques << endl;
+        }
+
+        if (!fichierTrace.empty()) {
+            metriques->ecrireTrace(fichierTrace);
+            cout << "[Métriques] Trace : " << fichierTrace << endl;
+        }
+    } catch (const exception &e) {
+        cerr << "[Erreur Métriques] " << e.what() << endl;
+    }
+}
+
+void SynchroniseurMultiVideo::configurerRenduNatif(bool natif) {
+    renduNatif = natif;
+}
+
+void SynchroniseurMultiVideo::configurerSegments(int nombre) {
+    segmentsRendu = nombre > 0 ? nombre : max(1, static_cast<int>(thread::hardware_concurrency()));
+}
+
+void SynchroniseurMultiVideo::configurerEncodage(const ProfilEncodage &profil) {
+    profilEncodage = profil;
+}
+
+void SynchroniseurMultiVideo::configurerFicheSynchro(const string &fichier, bool seulement) {
+    ficheSynchro = fichier;
+    ficheSeulement = seulement;
+}
+
+void SynchroniseurMultiVideo::configurerDirect(int frequence, double periode, double memoire, double plageSuivi) {
+    if (frequence > 0) frequenceDirect = frequence;
+    if (periode > 0) periodeDirect = periode;
+    if (memoire > 0) memoireDirect = memoire;
+    if (plageSuivi > 0) plageSuiviDirect = plageSuivi;
+}
+
+void SynchroniseurMultiVideo::configurerLot(size_t analyses, size_t encodages) {
+    if (analyses > 0) analysesLot = analyses;
+    if (encodages > 0) encodagesLot = encodages;
+}
+
+void SynchroniseurMultiVideo::estimerDerives(const string &fichierRef, vector<InfoVideo> &listeVideos,
+                                             int premierNumero) const {
+    EstimateurDerive estimateur(FREQUENCE_ECHANTILLONNAGE, dureeFenetreDerive, intervalleDerive, PLAGE_DERIVE);
+    estimateur.configurerMetriques(metriques.get());
+
+    // Les vidéos sont suivies l'une après l'autre, les fenêtres de chacune étant réparties sur tous les threads.
+    for (size_t i = 0; i < listeVideos.size(); ++i) {
+        InfoVideo &vid = listeVideos[i];
+
+        cout << "[Dérive] Vidéo " << premierNumero + i << " : " << flush;
+
+        try {
+            const EstimateurDerive::Modele modele = estimateur.estimer(fichierRef, vid.chemin, vid.retardSecondes,
+                                                                       nombreThreads);
+
+            vid.retardSecondes = modele.retard;
+            vid.derive = modele.derive;
+
+            cout << "OK (Retard : " << fixed << setprecision(3) << modele.retard << "s, dérive : "
+                    << setprecision(1) << modele.derive * 3.6e6 << " ms/h, " << modele.fenetres << " fenêtres)"
+                    << endl;
+        } catch (const exception &e) {
+            cout << "Échec (" << e.what() << ") - Décalage constant conservé" << endl;
+        }
+    }
+}
 
-    // Construction de la commande FFmpeg pour extraire l'audio.
-    // -y: Écrase le fichier de sortie s'il existe déjà.
-    // -hide_banner: Supprime l'affichage de la bannière FFmpeg.
-    // -loglevel error: N'affiche que les messages d'erreur graves.
-    // -i: Spécifie le fichier vidéo d'entrée.
-    // -vn: Ignore le flux vidéo (évite le décodage inutile).
-    // -f f32le: Définit le format de sortie de l'audio en float 32-bit little-endian.
-    // -ac 1: Convertit l'audio en mono.
-    // -ar FREQUENCE_ECHANTILLONNAGE: Définit la fréquence d'échantillonnage de l'audio.
-    // -t dureeAnalyse: Traite seulement les X premières secondes de la vidéo.
+int SynchroniseurMultiVideo::dimensionTuile(int dimension) const {
+    // Dimension paire, imposée par le sous-échantillonnage 4:2:0 de la chrominance.
+    return max(2, static_cast<int>(lround(dimension * profilEncodage.echelle / 2.0)) * 2);
+}
 
-    cmd << "ffmpeg -y -hide_banner -loglevel error "
-            << "-i \"" << fichierVideo << "\" "
-            << "-vn "
-            << "-f f32le -ac 1 -ar " << FREQUENCE_ECHANTILLONNAGE << " -t " << dureeAnalyse << " "
-            << "\"" << fichierAudioSortie << "\"";
+void SynchroniseurMultiVideo::chargerAudio(const string &fichier, vector<float> &sortie) const {
+    // Décode directement en mono, float 32 bits, à FREQUENCE_ECHANTILLONNAGE,
+    // en se limitant aux dureeAnalyse premières secondes.
+    Metriques::Etape etape(metriques.get(), "decodage audio", fichier);
 
-    // Exécute la commande FFmpeg.
-    if (system(cmd.str().c_str()) != 0) throw runtime_error("Impossible d'extraire l'audio de : " + fichierVideo);
+    DecodeurAudio decodeur(fichier, FREQUENCE_ECHANTILLONNAGE);
+    decodeur.lireTout(sortie, dureeAnalyse);
 }
 
-vector<float> SynchroniseurMultiVideo::chargerAudioBrut(const string &nomFichier) {
-    // Ouvre le fichier audio en mode binaire et se positionne à la fin pour obtenir la taille
-    ifstream fichier(nomFichier, ios::binary | ios::ate);
+SignalAudio SynchroniseurMultiVideo::obtenirSignal(const string &fichier) const {
+    if (dossierCache.empty()) {
+        vector<float> echantillons;
+        chargerAudio(fichier, echantillons);
+        return SignalAudio(std::move(echantillons));
+    }
+
+    const CacheAnalyse cache(dossierCache);
+    const string cle = CacheAnalyse::calculerCle(fichier, FREQUENCE_ECHANTILLONNAGE, dureeAnalyse);
+
+    // Fichier inchangé depuis une analyse précédente : projection directe, sans décodage.
+    {
+        Metriques::Etape etape(metriques.get(), "cache", fichier);
+        if (optional<SignalAudio> signal = cache.charger(cle, FREQUENCE_ECHANTILLONNAGE)) return std::move(*signal);
+    }
 
     vector<float> echantillons;
+    chargerAudio(fichier, echantillons);
+    cache.enregistrer(cle, FREQUENCE_ECHANTILLONNAGE, echantillons);
+
+    return SignalAudio(std::move(echantillons));
+}
+
+ResultatDecalage SynchroniseurMultiVideo::calculerDecalage(span<const float> ref, span<const float> cible,
+                                                           const IndexEmpreintes *indexRef, double aPriori) const {
+    if (ref.empty() || cible.empty()) throw runtime_error("Signal audio vide.");
+
+    const int n = min(ref.size(), cible.size());
+    const int debutScan = n / 3;
+    const int finScan = 2 * n / 3;
+
+    if (finScan <= debutScan) throw runtime_error("Signal audio trop court.");
+
+    const int plageMax = static_cast<int>(FREQUENCE_ECHANTILLONNAGE * plageRechercheMax);
+    const auto centre = static_cast<int>(lround(aPriori * FREQUENCE_ECHANTILLONNAGE));
+
+    // Chaque pic est noté sur la courbe que sa recherche vient de produire : aucune corrélation supplémentaire.
+    ResultatDecalage resultat;
+    CourbeRetards courbe;
+    double retard;
+    int plage;
+
+    if (methodeCorrelation == MethodeCorrelation::Empreinte) {
+        // Le vote n'a pas de plage : le pic est noté sur un voisinage étroit du retard voté.
+        retard = indexRef
+                     ? chercherRetardEmpreinte(ref, cible, *indexRef, courbe)
+                     : chercherRetardEmpreinte(ref, cible, IndexEmpreintes(ref, FREQUENCE_ECHANTILLONNAGE), courbe);
+        plage = plageMax;
+
+        noterPic(courbe, retard, resultat);
+    } else {
+        plage = rechercheProgressive
+                    ? min(plageMax, max(1, static_cast<int>(FREQUENCE_ECHANTILLONNAGE * fenetreInitiale)))
+                    : plageMax;
+
+        while (true) {
+            switch (methodeCorrelation) {
+                case MethodeCorrelation::FFT:
+                    retard = chercherRetardFFT(ref, cible, centre, plage, courbe);
+                    break;
+                case MethodeCorrelation::Hierarchique:
+                    retard = chercherRetardHierarchique(ref, cible, centre, plage, courbe);
+                    break;
+                default:
+                    retard = chercherRetardDirect(ref, cible, centre, plage, courbe);
+                    break;
+            }
+
+            noterPic(courbe, retard, resultat);
 
-    if (!fichier.is_open()) throw runtime_error("Impossible d'ouvrir le fichier : " + nomFichier);
+            // Un pic net qui ne touche pas le bord de la plage n'est pas un pic tronqué par la fenêtre.
+            const bool picNet = resultat.rapportPicLobes >= seuilRapportPicLobes
+                                && abs(retard - centre) < plage - DUREE_LOBE_PRINCIPAL * FREQUENCE_ECHANTILLONNAGE;
 
-    // Récupère la taille du fichier
-    streamsize taille = fichier.tellg();
-    // Repositionne le curseur au début du fichier
-    fichier.seekg(0, ios::beg);
-    // Calcule le nombre d'éléments que le fichier contient
-    int nbElements = taille / sizeof(float);
+            if (plage >= plageMax || picNet) break;
 
-    // Redimensionne le vecteur pour accueillir tous les échantillons
-    echantillons.resize(nbElements);
+            // Le tiers central est recorrélé à chaque passe : un facteur 4 limite le nombre de passes.
+            plage = min(plageMax, 4 * plage);
+        }
+    }
+
+    // Conversion échantillons -> secondes
+    resultat.decalage = retard / FREQUENCE_ECHANTILLONNAGE;
+    resultat.confiance = mesurerConfiance(ref, cible, resultat.decalage);
+    resultat.plageExploree = static_cast<double>(plage) / FREQUENCE_ECHANTILLONNAGE;
+
+    return resultat;
+}
+
+void SynchroniseurMultiVideo::noterPic(const CourbeRetards &courbe, double retard,
+                                       ResultatDecalage &resultat) const {
+    resultat.rapportPicLobes = 0.0;
+    resultat.margeSecondPic = 0.0;
 
-    // Si le fichier n'est pas vide, lit les données et remplit le vecteur "echantillons"
-    if (nbElements > 0) {
-        fichier.read(reinterpret_cast<char *>(echantillons.data()), taille);
-        if (!fichier) throw runtime_error("Erreur de lecture du fichier : " + nomFichier);
+    const auto taille = static_cast<int>(courbe.valeurs.size());
+
+    if (taille == 0) return;
+
+    // Le pic est cherché à ±1 point du retard trouvé, pour absorber l'affinage entre deux points de la grille.
+    const int indiceRetard = clamp(static_cast<int>(lround((retard - courbe.premierRetard) / courbe.pas)), 0,
+                                   taille - 1);
+    int indicePic = indiceRetard;
+    for (int k = max(0, indiceRetard - 1); k <= min(taille - 1, indiceRetard + 1); ++k) {
+        if (courbe.valeurs[k] > courbe.valeurs[indicePic]) indicePic = k;
     }
 
-    return echantillons;
+    const int lobePrincipal = max(2, static_cast<int>(DUREE_LOBE_PRINCIPAL * FREQUENCE_ECHANTILLONNAGE / courbe.pas));
+    resultat.noterNettete(courbe.valeurs, indicePic, lobePrincipal);
 }
 
-double SynchroniseurMultiVideo::calculerDecalage(const vector<float> &ref, const vector<float> &cible) const {
-    try {
-        if (ref.empty() || cible.empty()) return 0.0;
+ResultatDecalage SynchroniseurMultiVideo::mesurerDecalage(span<const float> ref, span<const float> cible,
+                                                          double aPriori) const {
+    return calculerDecalage(ref, cible, nullptr, aPriori);
+}
+
+ResultatDecalage SynchroniseurMultiVideo::mesurerDecalage(const string &fichierRef, const string &fichierCible,
+                                                          double aPriori) const {
+    if (memoireFlux > 0) return {calculerDecalageFlux(fichierRef, fichierCible, memoireFlux), -1.0};
+
+    // Signaux propres à l'appel : rien n'est partagé avec les mesures simultanées.
+    const SignalAudio signalRef = obtenirSignal(fichierRef);
+    const SignalAudio signalCible = obtenirSignal(fichierCible);
+
+    return calculerDecalage(signalRef.obtenirEchantillons(), signalCible.obtenirEchantillons(), nullptr, aPriori);
+}
+
+void SynchroniseurMultiVideo::suivreEnDirect(const string &fichierRef, const vector<string> &fichiersVideo,
+                                             const function<bool(size_t, const ResultatDecalage &)> &rappel) const {
+    SuiviDirect suivi(fichierRef, fichiersVideo, frequenceDirect, plageRechercheMax, periodeDirect, memoireDirect,
+                      plageSuiviDirect, seuilRapportPicLobes);
+    suivi.executer(rappel);
+}
+
+int SynchroniseurMultiVideo::obtenirFrequenceAnalyse() const {
+    return FREQUENCE_ECHANTILLONNAGE;
+}
+
+int SynchroniseurMultiVideo::chercherRetardDirect(span<const float> ref, span<const float> cible, int centre,
+                                                  int plage, CourbeRetards &courbe) const {
+    // Détermine la taille minimale des deux vecteurs pour éviter les débordements
+    const int n = min(ref.size(), cible.size());
+
+    double maxCorr = -1.0;
+    int meilleurDecalage = centre;
+
+    // On ne vérifie pas chaque échantillon, on saute de pasDePrecision en pasDePrecision pour aller plus vite
+    const int pas = pasDePrecision;
+
+    // On ne compare que le tiers central
+    const int debutScan = n / 3;
+    const int finScan = 2 * n / 3;
+
+    courbe = {{}, centre - plage, 20};
+
+    if (finScan <= debutScan) return centre;
+
+    // Les échantillons utilisés sont regroupés une fois pour toutes en tableaux contigus :
+    // la référence sous-échantillonnée, et la cible découpée en "pas" phases (cible[p + m * pas]).
+    // Chaque retard devient alors un produit scalaire contigu, vectorisable.
+    vector<float> refEchantillonnee;
+    for (int i = debutScan; i < finScan; i += pas) refEchantillonnee.push_back(ref[i]);
+
+    vector<vector<float> > phasesCible(pas);
+    for (int p = 0; p < pas; ++p) {
+        phasesCible[p].reserve(cible.size() / pas + 1);
+        for (size_t j = p; j < cible.size(); j += pas) phasesCible[p].push_back(cible[j]);
+    }
+
+    const auto nbTermes = static_cast<int>(refEchantillonnee.size());
+    const NoyauxCorrelation &noyaux = NoyauxCorrelation::obtenir();
+
+    // Boucle de corrélation croisée
+    for (int retard = centre - plage; retard < centre + plage; retard += 20) {
+        // Le terme t compare ref[debutScan + t * pas] à cible[debutScan + retard + t * pas],
+        // soit l'élément (q + t) de la phase p.
+        const int premierIndice = debutScan + retard;
+        const int p = ((premierIndice % pas) + pas) % pas;
+        const int q = (premierIndice - p) / pas;
+        const auto taillePhase = static_cast<int>(phasesCible[p].size());
+
+        // Bornes de la cible résolues ici, hors de la boucle critique
+        const int debut = max(0, -q);
+        const int fin = min(nbTermes, taillePhase - q);
+
+        const double corrActuelle = fin > debut
+                                        ? noyaux.produitScalaire(refEchantillonnee.data() + debut,
+                                                                 phasesCible[p].data() + q + debut, fin - debut)
+                                        : 0.0;
+
+        courbe.valeurs.push_back(corrActuelle);
+
+        // On garde le meilleur score
+        // Plus la corrélation est élevée, mieux c'est
+        if (corrActuelle > maxCorr) {
+            maxCorr = corrActuelle;
+            meilleurDecalage = retard;
+        }
+    }
+
+    Metriques::compterCorrelation(nbTermes, (2 * plage + 19) / 20);
+
+    return meilleurDecalage;
+}
+
+int SynchroniseurMultiVideo::chercherRetardFFT(span<const float> ref, span<const float> cible, int centre,
+                                               int plage, CourbeRetards &courbe) const {
+    const int n = min(ref.size(), cible.size());
+
+    // Même fenêtre que la méthode directe : le tiers central de la référence.
+    const int debutScan = n / 3;
+    const int finScan = 2 * n / 3;
+
+    courbe = {{}, centre - plage, 1};
+
+    if (finScan <= debutScan) return centre;
+
+    // Le segment commence à debutScan : un retard r correspond à l'indice debutScan + r dans la cible.
+    const span<const float> segmentRef = ref.subspan(debutScan, finScan - debutScan);
+
+    CorrelateurFFT correlateur;
+    vector<double> &correlation = courbe.valeurs;
+    correlateur.correler(segmentRef, cible, debutScan + centre - plage, debutScan + centre + plage, correlation);
+
+    // Retard de corrélation maximale, tous les échantillons étant évalués
+    const auto meilleur = max_element(correlation.begin(), correlation.end());
+
+    return static_cast<int>(meilleur - correlation.begin()) + centre - plage;
+}
+
+double SynchroniseurMultiVideo::chercherRetardHierarchique(span<const float> ref, span<const float> cible,
+                                                          int centre, int plage, CourbeRetards &courbe) const {
+    const int n = min(ref.size(), cible.size());
+
+    const int debutScan = n / 3;
+    const int finScan = 2 * n / 3;
+
+    courbe = {};
+
+    if (finScan <= debutScan) return centre;
+
+    // Étape 1 : décimation des deux signaux complets vers frequenceGrossiere.
+    const Decimateur decimateur(max(1, FREQUENCE_ECHANTILLONNAGE / frequenceGrossiere));
+    const auto facteur = static_cast<int>(decimateur.obtenirFacteur());
+
+    vector<float> refGrossiere, cibleGrossiere;
+    decimateur.decimer(ref, refGrossiere);
+    decimateur.decimer(cible, cibleGrossiere);
+
+    // Étape 2 : corrélation complète par FFT à basse résolution, sur toute la plage.
+    const int debutGrossier = debutScan / facteur;
+    const int finGrossier = min<int>(finScan / facteur, refGrossiere.size());
+    const int centreGrossier = static_cast<int>(lround(static_cast<double>(centre) / facteur));
+    const int plageGrossiere = plage / facteur + 1;
+
+    if (finGrossier <= debutGrossier) return chercherRetardFFT(ref, cible, centre, plage, courbe);
+
+    const span<const float> segmentGrossier = span<const float>(refGrossiere).subspan(
+        debutGrossier, finGrossier - debutGrossier);
+
+    // La courbe grossière sert aussi à noter le pic : un point par période grossière.
+    courbe.premierRetard = (centreGrossier - plageGrossiere) * facteur;
+    courbe.pas = facteur;
+
+    CorrelateurFFT correlateur;
+    vector<double> &correlation = courbe.valeurs;
+    correlateur.correler(segmentGrossier, cibleGrossiere, debutGrossier + centreGrossier - plageGrossiere,
+                         debutGrossier + centreGrossier + plageGrossiere, correlation);
+
+    // Étape 3 : sélection des maxima locaux les plus élevés, séparés d'au moins deux échantillons grossiers.
+    vector<int> pics;
+    for (int k = 1; k + 1 < static_cast<int>(correlation.size()); ++k) {
+        if (correlation[k] > correlation[k - 1] && correlation[k] >= correlation[k + 1]) pics.push_back(k);
+    }
+
+    if (pics.empty()) pics.push_back(static_cast<int>(max_element(correlation.begin(), correlation.end()) -
+                                                      correlation.begin()));
+
+    const size_t nbCandidats = min<size_t>(nombreCandidats, pics.size());
+    partial_sort(pics.begin(), pics.begin() + nbCandidats, pics.end(),
+                 [&correlation](int a, int b) { return correlation[a] > correlation[b]; });
+    pics.resize(nbCandidats);
+
+    // Étapes 4 et 5 : affinage à pleine fréquence dans une fenêtre de deux périodes grossières autour de chaque pic.
+    vector<int> retardsCandidats;
+    for (const int pic: pics) retardsCandidats.push_back((pic + centreGrossier - plageGrossiere) * facteur);
+
+    return affinerRetard(ref.subspan(debutScan, finScan - debutScan), debutScan, cible, retardsCandidats,
+                         2 * facteur, centre - plage, centre + plage);
+}
+
+double SynchroniseurMultiVideo::chercherRetardEmpreinte(span<const float> ref, span<const float> cible,
+                                                        const IndexEmpreintes &indexRef, CourbeRetards &courbe) const {
+    courbe = {};
+
+    const IndexEmpreintes::ResultatVote vote = indexRef.aligner(cible);
+
+    if (vote.votes < votesMinimum) {
+        throw runtime_error("Empreintes insuffisantes (" + to_string(vote.votes) + " repères concordants).");
+    }
+
+    const auto retardVote = static_cast<int>(vote.retard);
+
+    // Zone de la référence dont l'homologue existe dans la cible pour ce retard.
+    const int debutCommun = max(0, -retardVote);
+    const int finCommun = min<int>(ref.size(), static_cast<int>(cible.size()) - retardVote);
+
+    if (finCommun <= debutCommun) return retardVote;
+
+    // L'affinage se limite à quelques secondes au centre de cette zone : la fenêtre de retards est
+    // étroite, mais sa largeur (une trame) rend la corrélation exacte coûteuse sur de longs segments.
+    const int longueur = min(finCommun - debutCommun, FREQUENCE_ECHANTILLONNAGE * DUREE_AFFINAGE_EMPREINTE);
+    const int debutSegment = debutCommun + (finCommun - debutCommun - longueur) / 2;
+
+    const span<const float> segmentRef = ref.subspan(debutSegment, longueur);
+    const double retard = affinerRetard(segmentRef, debutSegment, cible, {retardVote}, indexRef.obtenirPasTrame(),
+                                        numeric_limits<int>::min() / 2, numeric_limits<int>::max() / 2);
+
+    // Courbe de notation : le même segment, à quelques largeurs de lobe du retard, indépendamment de plageMax.
+    const int demiLargeur = LOBES_NOTATION_EMPREINTE
+                            * max(1, static_cast<int>(DUREE_LOBE_PRINCIPAL * FREQUENCE_ECHANTILLONNAGE));
+    const int retardCentral = static_cast<int>(lround(retard));
+    courbe.premierRetard = retardCentral - demiLargeur;
+
+    CorrelateurFFT correlateur;
+    correlateur.correler(segmentRef, cible, debutSegment + retardCentral - demiLargeur,
+                         debutSegment + retardCentral + demiLargeur, courbe.valeurs);
+
+    return retard;
+}
+
+double SynchroniseurMultiVideo::affinerRetard(span<const float> segmentRef, int debutSegment,
+                                              span<const float> cible, const vector<int> &retardsCandidats,
+                                              int demiFenetre, int retardMinimal, int retardMaximal) const {
+    const NoyauxCorrelation &noyaux = NoyauxCorrelation::obtenir();
+
+    double meilleurScore = -numeric_limits<double>::infinity();
+    double meilleurRetard = retardsCandidats.empty() ? 0.0 : retardsCandidats.front();
+    vector<double> fenetre;
+
+    for (const int retardCentral: retardsCandidats) {
+        const int retardMin = max(retardCentral - demiFenetre, retardMinimal);
+        const int retardMax = min(retardCentral + demiFenetre, retardMaximal);
+
+        if (retardMax < retardMin) continue;
+
+        noyaux.correler(segmentRef, cible, debutSegment + retardMin, debutSegment + retardMax, fenetre);
+
+        const auto indice = static_cast<int>(max_element(fenetre.begin(), fenetre.end()) - fenetre.begin());
+
+        if (fenetre[indice] <= meilleurScore) continue;
+
+        meilleurScore = fenetre[indice];
+        meilleurRetard = retardMin + indice;
+
+        // Interpolation parabolique sur le pic et ses deux voisins.
+        if (indice > 0 && indice + 1 < static_cast<int>(fenetre.size())) {
+            const double gauche = fenetre[indice - 1];
+            const double centre = fenetre[indice];
+            const double droite = fenetre[indice + 1];
+            const double courbure = gauche - 2.0 * centre + droite;
+
+            if (courbure < 0.0) meilleurRetard += 0.5 * (gauche - droite) / courbure;
+        }
+    }
+
+    return meilleurRetard;
+}
+
+double SynchroniseurMultiVideo::calculerDecalageFlux(const string &fichierRef, const string &fichierCible,
+                                                     size_t memoireMax) const {
+    const auto plage = static_cast<int64_t>(FREQUENCE_ECHANTILLONNAGE * plageRechercheMax);
+    const auto longueurFenetre = static_cast<int64_t>(FREQUENCE_ECHANTILLONNAGE * dureeAnalyse);
+
+    // Choix de la taille de bloc : pour chaque taille de FFT, le plus grand bloc qui y tient,
+    // tant que le total (corrélateur, blocs de travail et tampons circulaires) respecte le budget.
+    int64_t tailleBloc = 0;
+
+    for (int64_t tailleFFT = 4096; tailleFFT <= (int64_t{1} << 31); tailleFFT *= 2) {
+        const int64_t candidat = min((tailleFFT - 2 * plage) / 2, longueurFenetre);
+        if (candidat < 1) continue;
+
+        const size_t memoire = CorrelateurIncremental::estimerMemoire(candidat, -plage, plage)
+                               + sizeof(float) * (2 * candidat + 2 * plage) // bloc de référence et segment de cible
+                               + sizeof(float) * (2 * candidat + 2 * plage + 2 * TAILLE_MORCEAU_FLUX); // tampons
+
+        if (memoire > memoireMax) break;
+
+        tailleBloc = candidat;
+        if (candidat == longueurFenetre) break;
+    }
+
+    if (tailleBloc == 0) throw runtime_error("Budget mémoire insuffisant pour la plage de recherche.");
+
+    LecteurAudioFlux lecteurRef(fichierRef, FREQUENCE_ECHANTILLONNAGE, tailleBloc + TAILLE_MORCEAU_FLUX,
+                                TAILLE_MORCEAU_FLUX);
+    LecteurAudioFlux lecteurCible(fichierCible, FREQUENCE_ECHANTILLONNAGE,
+                                  tailleBloc + 2 * plage + TAILLE_MORCEAU_FLUX, TAILLE_MORCEAU_FLUX);
+
+    CorrelateurIncremental correlateur(-plage, plage);
+
+    vector<float> blocRef(tailleBloc);
+    vector<float> segmentCible(tailleBloc + 2 * plage);
+
+    for (const double debut: debutsFenetres) {
+        const int64_t debutFenetre = llround(debut * FREQUENCE_ECHANTILLONNAGE);
+        const int64_t finFenetre = debutFenetre + longueurFenetre;
+
+        // La cible est lue à partir de plageRechercheMax secondes avant la fenêtre (zéros avant le début du fichier).
+        lecteurRef.chercher(debut);
+        lecteurCible.chercher(max(0.0, debut - plageRechercheMax));
+
+        for (int64_t a = debutFenetre; a < finFenetre; a += tailleBloc) {
+            const int64_t n = min(tailleBloc, finFenetre - a);
+
+            const span<float> bloc = span(blocRef).first(n);
+            const span<float> segment = span(segmentCible).first(n + 2 * plage);
+
+            const bool refComplete = lecteurRef.remplir(a + n);
+            lecteurRef.obtenirTampon().copier(a, bloc);
+
+            lecteurCible.remplir(a + n + plage);
+            lecteurCible.obtenirTampon().copier(a - plage, segment);
+
+            correlateur.accumuler(bloc, segment);
+
+            // Seuls les échantillons encore nécessaires au bloc suivant sont conservés.
+            lecteurRef.liberer(a + n);
+            lecteurCible.liberer(a + n - plage);
+
+            // Au-delà de la fin de la référence, le reste de la fenêtre ne contient que du silence.
+            if (!refComplete) break;
+        }
+    }
 
-        // Détermine la taille minimale des deux vecteurs pour éviter les débordements
-        const int n = min(ref.size(), cible.size());
+    const vector<double> &correlation = correlateur.obtenirCorrelation();
+    const auto meilleur = max_element(correlation.begin(), correlation.end());
 
-        double maxCorr = -1.0;
-        int meilleurDecalage = 0;
+    return static_cast<double>((meilleur - correlation.begin()) - plage) / FREQUENCE_ECHANTILLONNAGE;
+}
+
+vector<SynchroniseurMultiVideo::InfoVideo> SynchroniseurMultiVideo::analyserCibles(
+    const string &fichierRef, const vector<string> &fichiersVideo, int premierNumero, PoolThreads *pool) const {
+    if (alignementGlobal) return analyserGlobal(fichierRef, fichiersVideo, premierNumero, pool);
+
+    // Le pool ne dépasse jamais le nombre de vidéos à traiter.
+    const size_t taillePool = nombreThreads == 0
+                                  ? min<size_t>(max(1u, thread::hardware_concurrency()), fichiersVideo.size())
+                                  : min<size_t>(nombreThreads, fichiersVideo.size());
+
+    SignalAudio signalRef;
+
+    // En analyse en mémoire, la référence est décodée (ou relue du cache) une seule fois pour toutes les tâches.
+    if (memoireFlux == 0) {
+        try {
+            signalRef = obtenirSignal(fichierRef);
+        } catch (const exception &e) {
+            throw runtime_error(string("Erreur référence : ") + e.what());
+        }
+
+        if (signalRef.obtenirEchantillons().empty()) {
+            throw runtime_error("Fichier audio référence vide ou illisible.");
+        }
+    }
+
+    // L'index d'empreintes de la référence est construit une seule fois, puis partagé en lecture par les tâches.
+    optional<IndexEmpreintes> indexRef;
+    if (memoireFlux == 0 && methodeCorrelation == MethodeCorrelation::Empreinte) {
+        Metriques::Etape etape(metriques.get(), "index empreintes", fichierRef);
+        indexRef.emplace(signalRef.obtenirEchantillons(), FREQUENCE_ECHANTILLONNAGE);
+    }
+
+    const IndexEmpreintes *index = indexRef ? &*indexRef : nullptr;
 
-        // Définit la plage de recherche pour le décalage en échantillons
-        const int plageRecherche = static_cast<int>(FREQUENCE_ECHANTILLONNAGE * plageRechercheMax);
+    // Sans pool partagé, un pool propre à l'analyse borne le nombre de tâches simultanées.
+    optional<PoolThreads> poolLocal;
+    if (!pool) pool = &poolLocal.emplace(max<size_t>(taillePool, 1));
 
-        // Boucle de corrélation croisée
-        for (int retard = -plageRecherche; retard < plageRecherche; retard += 20) {
-            // On ne vérifie pas chaque échantillon, on saute de pasDePrecision en pasDePrecision pour aller plus vite
-            const int pas = pasDePrecision;
+    // Dans un pool partagé, seules taillePool tâches sont soumises d'avance : les autres travaux gardent leur part.
+    const size_t simultanees = max<size_t>(taillePool, 1);
+    const size_t fenetre = poolLocal ? fichiersVideo.size() : simultanees;
 
-            // On ne compare que le tiers central
-            const int debutScan = n / 3;
-            const int finScan = 2 * n / 3;
+    // Le budget de l'analyse en flux est partagé entre les tâches simultanées.
+    const size_t memoireParTache = memoireFlux / simultanees;
 
-            double corrActuelle = 0;
+    vector<future<ResultatDecalage> > decalages;
+    decalages.reserve(fichiersVideo.size());
 
-            for (int i = debutScan; i < finScan; i += pas) {
-                // Calcule l'indice correspondant dans le vecteur cible en appliquant le retard
-                int j = i + retard;
+    const span<const float> audioRef = signalRef.obtenirEchantillons();
 
-                if (j >= 0 && j < cible.size()) {
-                    // Accumule le produit des échantillons pour la corrélation
-                    corrActuelle += ref[i] * cible[j];
-                }
+    const auto soumettre = [&](const string &fichier) {
+        decalages.push_back(pool->soumettre([this, audioRef, index, &fichierRef, &fichier, memoireParTache] {
+            if (memoireFlux > 0) {
+                Metriques::Etape etape(metriques.get(), "analyse en flux", fichier);
+                return ResultatDecalage{calculerDecalageFlux(fichierRef, fichier, memoireParTache), -1.0};
             }
 
-            // On garde le meilleur score
-            // Plus la corrélation est élevée, mieux c'est
-            if (corrActuelle > maxCorr) {
-                maxCorr = corrActuelle;
-                meilleurDecalage = retard;
+            // Signal propre à la tâche : aucune donnée partagée entre les vidéos cibles.
+            const SignalAudio signalCible = obtenirSignal(fichier);
+
+            Metriques::Etape etape(metriques.get(), "correlation", fichier);
+            return calculerDecalage(audioRef, signalCible.obtenirEchantillons(), index);
+        }));
+    };
+
+    vector<InfoVideo> listeVideos;
+
+    // Les résultats sont relus dans l'ordre d'entrée, quel que soit l'ordre d'achèvement.
+    for (size_t i = 0; i < fichiersVideo.size(); ++i) {
+        // Chaque résultat relu libère une place pour la vidéo suivante.
+        while (decalages.size() < min(fichiersVideo.size(), i + fenetre)) soumettre(fichiersVideo[decalages.size()]);
+
+        cout << "[2/3] Analyse vidéo " << premierNumero + i << " : " << flush;
+
+        try {
+            const ResultatDecalage resultat = pool->attendre(decalages[i]);
+
+            // Ajoute la vidéo à la liste avec son décalage (l'analyse en flux ne mesure pas la confiance).
+            listeVideos.push_back({fichiersVideo[i], resultat.decalage});
+            if (resultat.confiance >= 0.0) listeVideos.back().confiance = resultat.confiance;
+
+            cout << "OK (Retard : " << fixed << setprecision(3) << resultat.decalage << "s";
+            if (resultat.confiance >= 0.0) {
+                cout << ", confiance : " << setprecision(2) << resultat.confiance
+                        << ", pic/lobes : " << setprecision(1) << resultat.rapportPicLobes
+                        << ", marge : " << setprecision(2) << resultat.margeSecondPic;
             }
+            cout << ")" << endl;
+        } catch (const exception &e) {
+            cout << "Échec (" << e.what() << ") - Vidéo ignorée" << endl;
         }
+    }
 
-        // Conversion échantillons -> secondes
-        return static_cast<double>(meilleurDecalage) / FREQUENCE_ECHANTILLONNAGE;
-    } catch (const exception &e) {
-        cerr << "[Erreur Calcul] " << e.what() << endl;
-        return 0.0;
+    return listeVideos;
+}
+
+double SynchroniseurMultiVideo::mesurerConfiance(span<const float> ref, span<const float> cible,
+                                                 double decalage) const {
+    const auto retard = static_cast<ptrdiff_t>(llround(decalage * FREQUENCE_ECHANTILLONNAGE));
+
+    // Partie de la référence dont l'homologue existe dans la cible.
+    const ptrdiff_t debut = max<ptrdiff_t>(0, -retard);
+    const ptrdiff_t fin = min<ptrdiff_t>(ref.size(), static_cast<ptrdiff_t>(cible.size()) - retard);
+
+    if (fin <= debut) return 0.0;
+
+    const NoyauxCorrelation &noyaux = NoyauxCorrelation::obtenir();
+    const float *a = ref.data() + debut;
+    const float *b = cible.data() + debut + retard;
+    const size_t n = fin - debut;
+
+    const double energie = noyaux.produitScalaire(a, a, n) * noyaux.produitScalaire(b, b, n);
+
+    if (energie <= 0.0) return 0.0;
+
+    return clamp(noyaux.produitScalaire(a, b, n) / sqrt(energie), 0.0, 1.0);
+}
+
+vector<SynchroniseurMultiVideo::InfoVideo> SynchroniseurMultiVideo::analyserGlobal(
+    const string &fichierRef, const vector<string> &fichiersVideo, int premierNumero, PoolThreads *pool) const {
+    // Nœud 0 : la référence ; nœuds suivants : les vidéos, dans l'ordre d'entrée.
+    vector<string> fichiers = {fichierRef};
+    fichiers.insert(fichiers.end(), fichiersVideo.begin(), fichiersVideo.end());
+
+    const size_t nbFichiers = fichiers.size();
+
+    optional<PoolThreads> poolLocal;
+    if (!pool) pool = &poolLocal.emplace(nombreThreads);
+
+    // Étape 1 : chaque fichier est décodé (ou relu du cache) une seule fois, puis partagé par toutes ses paires.
+    vector<SignalAudio> signaux(nbFichiers);
+    vector<optional<IndexEmpreintes> > index(nbFichiers);
+    vector<future<void> > decodages;
+
+    for (size_t k = 0; k < nbFichiers; ++k) {
+        decodages.push_back(pool->soumettre([this, &fichiers, &signaux, &index, k] {
+            signaux[k] = obtenirSignal(fichiers[k]);
+
+            if (methodeCorrelation == MethodeCorrelation::Empreinte && k + 1 < fichiers.size()) {
+                Metriques::Etape etape(metriques.get(), "index empreintes", fichiers[k]);
+                index[k].emplace(signaux[k].obtenirEchantillons(), FREQUENCE_ECHANTILLONNAGE);
+            }
+        }));
+    }
+
+    vector<string> erreurs(nbFichiers);
+    for (size_t k = 0; k < nbFichiers; ++k) {
+        try {
+            pool->attendre(decodages[k]);
+            if (signaux[k].obtenirEchantillons().empty()) erreurs[k] = "audio vide ou illisible";
+        } catch (const exception &e) {
+            erreurs[k] = e.what();
+        }
+    }
+
+    if (!erreurs[0].empty()) throw runtime_error("Erreur référence : " + erreurs[0]);
+
+    // Étape 2 : toutes les paires de fichiers décodés, le premier servant de référence à la paire.
+    struct Paire {
+        size_t i;
+        size_t j;
+        future<ResultatDecalage> mesure;
+    };
+
+    vector<Paire> paires;
+
+    for (size_t i = 0; i < nbFichiers; ++i) {
+        for (size_t j = i + 1; j < nbFichiers; ++j) {
+            if (!erreurs[i].empty() || !erreurs[j].empty()) continue;
+
+            paires.push_back({i, j, pool->soumettre([this, &fichiers, &signaux, &index, i, j] {
+                Metriques::Etape etape(metriques.get(), "correlation", fichiers[i] + " | " + fichiers[j]);
+
+                return calculerDecalage(signaux[i].obtenirEchantillons(), signaux[j].obtenirEchantillons(),
+                                        index[i] ? &*index[i] : nullptr);
+            })});
+        }
+    }
+
+    // Étape 3 : chronologie globale pondérée par la confiance des paires.
+    GrapheAlignement graphe(nbFichiers);
+    for (Paire &paire: paires) {
+        try {
+            const ResultatDecalage resultat = pool->attendre(paire.mesure);
+            graphe.ajouterMesure(paire.i, paire.j, resultat.decalage, resultat.confiance);
+        } catch (const exception &) {
+            // Paire sans retard trouvé : aucune mesure, ses fichiers restent reliés par les autres paires.
+        }
+    }
+
+    const vector<GrapheAlignement::Position> positions = graphe.resoudre(confianceMinimale, TOLERANCE_ALIGNEMENT);
+
+    vector<InfoVideo> listeVideos;
+
+    for (size_t k = 1; k < nbFichiers; ++k) {
+        cout << "[2/3] Analyse vidéo " << premierNumero + k - 1 << " : ";
+
+        if (!erreurs[k].empty()) {
+            cout << "Échec (" << erreurs[k] << ") - Vidéo ignorée" << endl;
+        } else if (!positions[k].connecte) {
+            cout << "Échec (aucune paire fiable avec les autres fichiers) - Vidéo ignorée" << endl;
+        } else {
+            listeVideos.push_back({fichiers[k], positions[k].retard, positions[k].confiance});
+
+            cout << "OK (Retard : " << fixed << setprecision(3) << positions[k].retard
+                    << "s, confiance : " << setprecision(2) << positions[k].confiance
+                    << ", résidu : " << setprecision(3) << positions[k].residu << "s)" << endl;
+        }
     }
+
+    return listeVideos;
 }
 
 bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos, const string &fichierSortie,
                                            const string &fichierAudioRef) const {
     cout << "[3/3] Génération de la vidéo finale..." << endl;
 
+    // Chronologie commune : l'audio de référence éventuel (retard nul) puis chaque vidéo, dans l'ordre des entrées.
+    Chronologie chronologie(recouvrementSeul);
+
+    {
+        Metriques::Etape etape(metriques.get(), "chronologie");
+
+        if (!fichierAudioRef.empty()) chronologie.ajouterSource(0.0, DecodeurAudio::mesurerDuree(fichierAudioRef));
+
+        for (const auto &vid: listeVideos) {
+            chronologie.ajouterSource(vid.retardSecondes, DecodeurAudio::mesurerDuree(vid.chemin));
+        }
+    }
+
+    vector<Chronologie::Placement> placements = chronologie.placer();
+    const double dureeSortie = chronologie.obtenirDuree();
+
+    // Une vidéo qui dérive a pris derive * t secondes d'avance à l'instant t de la référence :
+    // sa lecture commence d'autant plus loin. Le zéro commun est lu sur la référence (première source).
+    const double zeroReference = placements[0].debutLecture - placements[0].delai;
+
+    for (size_t i = 0; i < listeVideos.size(); ++i) {
+        Chronologie::Placement &placement = placements[i + (fichierAudioRef.empty() ? 0 : 1)];
+        if (placement.delai == 0.0) placement.debutLecture += listeVideos[i].derive * zeroReference;
+    }
+
+    if (!ficheSynchro.empty()) {
+        vector<FicheSynchro::Element> elements;
+
+        if (!fichierAudioRef.empty()) elements.push_back({fichierAudioRef, false, 0.0, 1.0, 0.0, placements[0]});
+
+        for (size_t i = 0; i < listeVideos.size(); ++i) {
+            const InfoVideo &vid = listeVideos[i];
+            elements.push_back({vid.chemin, true, vid.retardSecondes, vid.confiance, vid.derive,
+                                placements[i + (fichierAudioRef.empty() ? 0 : 1)]});
+        }
+
+        FicheSynchro::ecrire(ficheSynchro, elements, dureeSortie, profilEncodage.imagesParSeconde);
+        cout << "[Succès] Fiche de synchronisation : " << ficheSynchro << endl;
+
+        // Les outils en aval recopient les flux eux-mêmes : aucun encodage n'est nécessaire.
+        if (ficheSeulement) return true;
+    }
+
+    // Le rendu natif a besoin d'une durée connue ; sinon, la ligne de commande s'arrête d'elle-même en fin de flux.
+    if (renduNatif && isfinite(dureeSortie)) {
+        return genererVideoNative(listeVideos, placements, dureeSortie, fichierSortie, fichierAudioRef);
+    }
+
+    const int largeurTuile = dimensionTuile(LARGEUR_CIBLE);
+    const int hauteurTuile = dimensionTuile(HAUTEUR_CIBLE);
+
+    // Décodage réduit : chaque vidéo n'est décodée qu'à la taille et à la cadence utiles à sa tuile.
+    vector<DecodeurVideo::Reduction> reductions(listeVideos.size());
+
+    if (profilEncodage.decodageReduit) {
+        for (size_t i = 0; i < listeVideos.size(); ++i) {
+            try {
+                reductions[i] = DecodeurVideo::sonder(listeVideos[i].chemin, largeurTuile, hauteurTuile,
+                                                      profilEncodage.imagesParSeconde,
+                                                      profilEncodage.imagesBEcartees);
+            } catch (const exception &) {
+                // Fichier illisible : ffmpeg le signalera lui-même, sans décodage réduit.
+            }
+        }
+    }
+
     stringstream cmd;
 
     // Construction de la commande FFmpeg.
@@ -145,20 +915,29 @@ bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos,
     // -loglevel warning : Affiche uniquement les avertissements et erreurs (réduit le bruit dans la console).
     cmd << "ffmpeg -y -hide_banner -loglevel warning ";
 
+    cmd << fixed << setprecision(3);
+
+    // -ss (avant -i) : positionne la lecture sur le zéro commun, y compris pour un retard négatif
+    // compensé par les autres entrées. -t (avant -i) : arrête la lecture à la fin de la sortie,
+    // sans décoder d'images ensuite écartées.
+    const auto ajouterEntree = [&cmd](const string &chemin, const Chronologie::Placement &placement) {
+        if (placement.debutLecture > 0.0) cmd << "-ss " << placement.debutLecture << " ";
+        if (isfinite(placement.duree)) cmd << "-t " << placement.duree << " ";
+        cmd << "-i \"" << chemin << "\" ";
+    };
+
     // Si un fichier audio de référence externe est fourni, on l'ajoute comme première entrée (index 0).
-    if (!fichierAudioRef.empty()) {
-        cmd << "-i \"" << fichierAudioRef << "\" ";
-    }
+    if (!fichierAudioRef.empty()) ajouterEntree(fichierAudioRef, placements[0]);
 
     // Ajout de chaque vidéo source à la commande.
-    for (const auto &vid: listeVideos) {
-        // Si un retard (décalage) est détecté pour cette vidéo, on utilise l'option -ss (seek start).
-        // Cela permet de caler la vidéo au bon moment par rapport à l'audio de référence.
-        if (vid.retardSecondes > 0) {
-            cmd << "-ss " << vid.retardSecondes << " ";
-        }
-        // Ajout du fichier vidéo comme entrée.
-        cmd << "-i \"" << vid.chemin << "\" ";
+    // -lowres (avant -i) : décodage à résolution réduite, pour les codecs qui le permettent.
+    // -skip_frame nonref (avant -i) : images non référencées écartées avant décodage, seulement si les images
+    // restantes suffisent à la cadence de sortie (voir DecodeurVideo::sonder).
+    for (size_t i = 0; i < listeVideos.size(); ++i) {
+        if (reductions[i].resolution > 0) cmd << "-lowres " << reductions[i].resolution << " ";
+        if (reductions[i].nonReferencees) cmd << "-skip_frame nonref ";
+
+        ajouterEntree(listeVideos[i].chemin, placements[i + (fichierAudioRef.empty() ? 0 : 1)]);
     }
 
     // Début de la définition du filtre complexe (-filter_complex).
@@ -169,6 +948,7 @@ bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos,
     // Si un audio externe est utilisé (index 0), la première vidéo est à l'index 1.
     // Sinon, la première vidéo est à l'index 0.
     int indexVideoStart = fichierAudioRef.empty() ? 0 : 1;
+
     int nbVideos = listeVideos.size();
 
     // Calcul des dimensions de la grille (lignes x colonnes).
@@ -176,11 +956,36 @@ bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos,
     int cols = ceil(sqrt(nbVideos));
 
     // Étape 1 : Redimensionnement de chaque vidéo.
-    // Chaque vidéo est redimensionnée à la taille cible (LARGEUR_CIBLE x HAUTEUR_CIBLE).
+    // Chaque vidéo est redimensionnée à la taille cible (LARGEUR_CIBLE x HAUTEUR_CIBLE, à l'échelle du profil).
     // On attribue une étiquette temporaire [v0], [v1], etc. à chaque sortie redimensionnée.
+    // Une vidéo qui démarre après le zéro commun est précédée d'images noires (tpad), et une vidéo
+    // qui se termine avant la fin de la sortie est complétée de la même façon. Une vidéo dont l'horloge
+    // dérive voit ses horodatages ramenés à ceux de la référence (setpts). Les images en trop sont écartées
+    // (fps) avant la mise à l'échelle, plutôt qu'après par -r, et une source au moins deux fois plus grande
+    // que la tuile est réduite par l'interpolation rapide.
     for (int i = 0; i < nbVideos; ++i) {
-        cmd << "[" << (i + indexVideoStart) << ":v]scale=" << LARGEUR_CIBLE << ":" << HAUTEUR_CIBLE << "[v" << i <<
-                "];";
+        const Chronologie::Placement &placement = placements[i + indexVideoStart];
+        const double vitesse = 1.0 + listeVideos[i].derive;
+
+        cmd << "[" << (i + indexVideoStart) << ":v]";
+
+        if (vitesse != 1.0) cmd << "setpts=(PTS-STARTPTS)/" << setprecision(9) << vitesse << setprecision(3) << ",";
+
+        cmd << "fps=" << profilEncodage.imagesParSeconde << ",";
+
+        cmd << "scale=" << largeurTuile << ":" << hauteurTuile;
+
+        if (profilEncodage.decodageReduit && reductions[i].largeur >= 2 * largeurTuile
+            && reductions[i].hauteur >= 2 * hauteurTuile) {
+            cmd << ":flags=fast_bilinear";
+        }
+
+        if (placement.delai > 0.0) cmd << ",tpad=start_mode=add:color=black:start_duration=" << placement.delai;
+
+        const double manque = dureeSortie - placement.delai - placement.duree / vitesse;
+        if (isfinite(manque) && manque > 0.0) cmd << ",tpad=stop_mode=add:color=black:stop_duration=" << manque;
+
+        cmd << "[v" << i << "];";
     }
 
     // Étape 2 : Assemblage des vidéos avec le filtre xstack.
@@ -234,26 +1039,62 @@ bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos,
     }
 
     // Étiquette de sortie du filtre complexe
-    cmd << "[vout]\" ";
+    cmd << "[vout]";
+
+    // L'audio de la première entrée est retardé d'autant que son image, s'il démarre après le zéro commun.
+    const bool audioRetarde = placements[0].delai > 0.0;
+
+    if (audioRetarde) {
+        cmd << ";[0:a]adelay=delays=" << llround(placements[0].delai * 1000.0) << ":all=1[aout]";
+    }
+
+    cmd << "\" ";
 
     // Mapping des flux pour le fichier de sortie.
     // -map "[vout]" : Utilise la vidéo générée par le filtre complexe.
     // -map 0:a : Utilise l'audio de la première entrée (fichier de référence ou première vidéo).
-    cmd << "-map \"[vout]\" -map 0:a ";
+    cmd << "-map \"[vout]\" -map " << (audioRetarde ? "\"[aout]\" " : "0:a ");
+
+    // Durée de la sortie : la piste la plus longue ne prolonge pas la vidéo au-delà de la chronologie.
+    if (isfinite(dureeSortie)) cmd << "-t " << dureeSortie << " ";
 
     // Options d'encodage vidéo :
 
+    const ProfilEncodage &profil = profilEncodage;
+
     cmd << "-c:v libx264 " // Encodeur H.264.
-            << "-r 30 " // Définir le framerate à 30 FPS
-            << "-profile:v baseline " // Profil simple pour la compatibilité.
-            << "-tune zerolatency " // Optimisation pour réduire la latence.
+            << "-r " << profil.imagesParSeconde << " " // Cadence de sortie du profil.
+            << "-profile:v " << profil.profil << " " // Profil H.264 (baseline pour la compatibilité, high pour la qualité).
             << "-pix_fmt yuv420p " // Format de pixel standard pour la compatibilité.
-            << "-preset fast " // (ultrafast, superfast, veryfast, fast, medium, slow...)
-            << "-movflags +faststart \"" // Déplace les métadonnées au début du fichier.
+            << "-preset " << profil.preset << " " // (ultrafast, superfast, veryfast, fast, medium, slow...)
+            << "-g " << profil.tailleGOP << " "; // Nombre maximal d'images entre deux images clés.
+
+    // Réglage optionnel (zerolatency : optimisation pour réduire la latence).
+    if (!profil.reglage.empty()) cmd << "-tune " << profil.reglage << " ";
+
+    // Débit cible, ou qualité constante.
+    if (profil.debitBinaire > 0) {
+        cmd << "-b:v " << profil.debitBinaire << "k ";
+    } else {
+        cmd << "-crf " << profil.crf << " ";
+    }
+
+    // Threads de l'encodeur : images en parallèle (débit) ou tranches d'une même image (latence).
+    const int threadsEncodeur = profil.threads > 0 ? profil.threads : coeursRendu;
+    if (threadsEncodeur > 0) cmd << "-threads " << threadsEncodeur << " ";
+    cmd << "-thread_type " << (profil.parallelisme == ProfilEncodage::Parallelisme::Tranches ? "slice" : "frame") << " ";
+
+    cmd << "-movflags +faststart \"" // Déplace les métadonnées au début du fichier.
             << fichierSortie << "\"";
 
     // Exécution de la commande système.
-    if (system(cmd.str().c_str()) == 0) {
+    int retour;
+    {
+        Metriques::Etape etape(metriques.get(), "ffmpeg", fichierSortie);
+        retour = system(cmd.str().c_str());
+    }
+
+    if (retour == 0) {
         cout << "[Succès] Fichier généré : " << fichierSortie << endl;
         return true;
     }
@@ -261,58 +1102,107 @@ bool SynchroniseurMultiVideo::genererVideo(const vector<InfoVideo> &listeVideos,
     throw runtime_error("Une erreur est survenue lors de l'encodage FFmpeg.");
 }
 
-bool SynchroniseurMultiVideo::genererVideoSynchronisee(const vector<string> &fichiersEntree,
-                                                       const string &fichierSortie) const {
-    try {
-        if (fichiersEntree.size() < 2) {
-            throw runtime_error("Il faut fournir au moins 2 fichiers vidéos.");
-        }
+bool SynchroniseurMultiVideo::genererVideoNative(const vector<InfoVideo> &listeVideos,
+                                                 const vector<Chronologie::Placement> &placements, double duree,
+                                                 const string &fichierSortie, const string &fichierAudioRef) const {
+    // Les placements commencent par l'audio de référence externe, s'il y en a un.
+    const size_t premierPlacementVideo = fichierAudioRef.empty() ? 0 : 1;
+
+    vector<RenduMosaique::Entree> entrees;
+    for (size_t i = 0; i < listeVideos.size(); ++i) {
+        const Chronologie::Placement &placement = placements[i + premierPlacementVideo];
+        entrees.push_back({
+            listeVideos[i].chemin, placement.debutLecture, placement.delai, placement.duree,
+            1.0 + listeVideos[i].derive
+        });
+    }
 
-        cout << "Traitement de " << fichiersEntree.size() << " vidéos" << endl;
+    const int largeur = dimensionTuile(LARGEUR_CIBLE);
+    const int hauteur = dimensionTuile(HAUTEUR_CIBLE);
+
+    // Audio de la première entrée (fichier de référence ou première vidéo), recopié sans réencodage.
+    const string &fichierAudio = fichierAudioRef.empty() ? listeVideos[0].chemin : fichierAudioRef;
+
+    RenduMosaique::Statistiques stats;
+
+    if (segmentsRendu > 1) {
+        RenduSegmente rendu(entrees, largeur, hauteur, profilEncodage, segmentsRendu);
+        rendu.configurerThreads(coeursRendu);
+        rendu.configurerMetriques(metriques.get());
+        rendu.configurerAudio(fichierAudio, placements[0].debutLecture, placements[0].delai);
+        stats = rendu.generer(fichierSortie, duree);
+    } else {
+        RenduMosaique rendu(entrees, largeur, hauteur, profilEncodage);
+        rendu.configurerThreads(coeursRendu);
+        rendu.configurerMetriques(metriques.get());
+        rendu.configurerAudio(fichierAudio, placements[0].debutLecture, placements[0].delai);
+        stats = rendu.generer(fichierSortie, duree);
+    }
 
-        cout << "[1/3] Analyse de la référence vidéo..." << endl;
+    const auto debit = [&stats](double secondes) { return secondes > 0.0 ? stats.images / secondes : 0.0; };
 
-        try {
-            extraireAudio(fichiersEntree[0], TEMP_AUDIO_REF);
-        } catch (const exception &e) {
-            throw runtime_error(string("Erreur référence : ") + e.what());
-        }
+    cout << "[Rendu] " << stats.images << " images en " << fixed << setprecision(2) << stats.secondesTotal
+            << "s (" << setprecision(1) << debit(stats.secondesTotal) << " img/s)" << endl;
+    cout << "        Décodage : " << setprecision(2) << stats.secondesDecodage << "s cumulées, "
+            << "mise à l'échelle : " << stats.secondesMiseAEchelle << "s cumulées, "
+            << "encodage : " << stats.secondesEncodage << "s (" << setprecision(1)
+            << debit(stats.secondesEncodage) << " img/s)" << endl;
 
-        vector<float> audioRef = chargerAudioBrut(TEMP_AUDIO_REF);
+    cout << "[Succès] Fichier généré : " << fichierSortie << endl;
+    return true;
+}
 
-        if (audioRef.empty()) {
-            throw runtime_error("Fichier audio référence vide ou illisible.");
+vector<SynchroniseurMultiVideo::InfoVideo> SynchroniseurMultiVideo::analyserEntrees(
+    const string &fichierAudioRef, const vector<string> &fichiersVideo, PoolThreads *pool) const {
+    if (fichierAudioRef.empty()) {
+        if (fichiersVideo.size() < 2) {
+            throw runtime_error("Il faut fournir au moins 2 fichiers vidéos.");
         }
 
+        cout << "Traitement de " << fichiersVideo.size() << " vidéos" << endl;
+
+        cout << "[1/3] Analyse de la référence vidéo..." << endl;
+
         vector<InfoVideo> listeVideos;
 
         // Ajoute la vidéo de référence à la liste avec un décalage de 0.
-        listeVideos.push_back({fichiersEntree[0], 0.0});
+        listeVideos.push_back({fichiersVideo[0], 0.0});
 
-        // Boucle sur les vidéos cibles (à partir de la deuxième).
-        for (int i = 1; i < fichiersEntree.size(); ++i) {
-            cout << "[2/3] Analyse vidéo " << i + 1 << " : " << flush;
+        // Analyse des vidéos cibles (à partir de la deuxième).
+        const vector<string> fichiersCibles(fichiersVideo.begin() + 1, fichiersVideo.end());
+        vector<InfoVideo> videosAnalysees = analyserCibles(fichiersVideo[0], fichiersCibles, 2, pool);
 
-            try {
-                // Extrait l'audio de la vidéo cible actuelle dans un fichier temporaire.
-                extraireAudio(fichiersEntree[i], TEMP_AUDIO_CIBLE);
+        if (suiviDerive) estimerDerives(fichiersVideo[0], videosAnalysees, 2);
+
+        listeVideos.insert(listeVideos.end(), videosAnalysees.begin(), videosAnalysees.end());
+        return listeVideos;
+    }
 
-                vector<float> audioCible = chargerAudioBrut(TEMP_AUDIO_CIBLE);
+    if (fichiersVideo.empty()) {
+        throw runtime_error("Il faut fournir au moins 1 fichier vidéo.");
+    }
 
-                double decalage = calculerDecalage(audioRef, audioCible);
+    cout << "[1/3] Analyse de la référence audio..." << endl;
 
-                // Ajoute la vidéo à la liste avec son décalage.
-                listeVideos.push_back({fichiersEntree[i], decalage});
+    // Analyse des vidéos cibles.
+    vector<InfoVideo> listeVideos = analyserCibles(fichierAudioRef, fichiersVideo, 1, pool);
 
-                cout << "OK (Retard : " << fixed << setprecision(3) << decalage << "s)" << endl;
-            } catch (const exception &e) {
-                cout << "Échec (" << e.what() << ") - Vidéo ignorée" << endl;
-            }
-        }
+    if (suiviDerive) estimerDerives(fichierAudioRef, listeVideos, 1);
 
-        return genererVideo(listeVideos, fichierSortie);
+    return listeVideos;
+}
+
+bool SynchroniseurMultiVideo::genererVideoSynchronisee(const vector<string> &fichiersEntree,
+                                                       const string &fichierSortie) const {
+    demarrerMetriques();
+
+    try {
+        const bool succes = genererVideo(analyserEntrees("", fichiersEntree), fichierSortie);
+        ecrireMetriques();
+        return succes;
     } catch (const exception &e) {
         cerr << "[Erreur] " << e.what() << endl;
+        ecrireMetriques();
         return false;
     }
 }
@@ -320,51 +1210,59 @@ bool SynchroniseurMultiVideo::genererVideoSynchronisee(const vector<string> &fic
 bool SynchroniseurMultiVideo::genererVideoSynchronisee(const string &fichierAudioRef,
                                                        const vector<string> &fichiersVideo,
                                                        const string &fichierSortie) const {
-    try {
-        if (fichiersVideo.empty()) {
-            throw runtime_error("Il faut fournir au moins 1 fichier vidéo.");
-        }
+    demarrerMetriques();
 
-        cout << "[1/3] Analyse de la référence audio..." << endl;
+    try {
+        const bool succes = genererVideo(analyserEntrees(fichierAudioRef, fichiersVideo), fichierSortie,
+                                         fichierAudioRef);
+        ecrireMetriques();
+        return succes;
+    } catch (const exception &e) {
+        cerr << "[Erreur] " << e.what() << endl;
+        ecrireMetriques();
+        return false;
+    }
+}
 
-        try {
-            extraireAudio(fichierAudioRef, TEMP_AUDIO_REF);
-        } catch (const exception &e) {
-            throw runtime_error(string("Erreur référence audio : ") + e.what());
-        }
+vector<bool> SynchroniseurMultiVideo::genererLot(const vector<LotSynchronisation::Travail> &travaux) const {
+    demarrerMetriques();
 
-        vector<float> audioRef = chargerAudioBrut(TEMP_AUDIO_REF);
+    const LotSynchronisation lot(analysesLot, encodagesLot, nombreThreads);
 
-        if (audioRef.empty()) {
-            throw runtime_error("Fichier audio référence vide ou illisible.");
-        }
+    // Les encodages s'exécutent hors des tâches du pool : leurs threads se partagent les cœurs du lot.
+    const int coeursLot = nombreThreads > 0 ? static_cast<int>(nombreThreads)
+                                            : max(1, static_cast<int>(thread::hardware_concurrency()));
+    const int coeursParEncodage = max(1, coeursLot / static_cast<int>(encodagesLot));
 
-        vector<InfoVideo> listeVideos;
-
-        // Boucle sur les vidéos cibles.
-        for (int i = 0; i < fichiersVideo.size(); ++i) {
-            cout << "[2/3] Analyse vidéo " << i + 1 << " : " << flush;
+    const vector<bool> reussites = lot.executer(travaux, [this, coeursParEncodage](
+                                                    const LotSynchronisation::Travail &travail,
+                                                    PoolThreads &pool) -> LotSynchronisation::Encodage {
+        // Copie propre au travail : elle partage le cache et les métriques, mais pas la fiche ni le parallélisme.
+        auto config = make_shared<SynchroniseurMultiVideo>(*this);
+        if (travail.parallelisme > 0) config->nombreThreads = travail.parallelisme;
+        config->ficheSynchro = travail.fiche;
+        config->coeursRendu = coeursParEncodage;
 
-            try {
-                // Extrait l'audio de la vidéo cible actuelle dans un fichier temporaire.
-                extraireAudio(fichiersVideo[i], TEMP_AUDIO_CIBLE);
+        vector<InfoVideo> listeVideos = config->analyserEntrees(travail.audioRef, travail.videos, &pool);
 
-                vector<float> audioCible = chargerAudioBrut(TEMP_AUDIO_CIBLE);
+        return [config, listeVideos = std::move(listeVideos), &travail] {
+            return config->genererVideo(listeVideos, travail.sortie, travail.audioRef);
+        };
+    });
 
-                double decalage = calculerDecalage(audioRef, audioCible);
-
-                // Ajoute la vidéo à la liste avec son décalage.
-                listeVideos.push_back({fichiersVideo[i], decalage});
+    ecrireMetriques();
+    return reussites;
+}
 
-                cout << "OK (Retard : " << fixed << setprecision(3) << decalage << "s)" << endl;
-            } catch (const exception &e) {
-                cout << "Échec (" << e.what() << ") - Vidéo ignorée" << endl;
-            }
-        }
+vector<bool> SynchroniseurMultiVideo::genererLot(const string &manifeste) const {
+    vector<LotSynchronisation::Travail> travaux;
 
-        return genererVideo(listeVideos, fichierSortie, fichierAudioRef);
+    try {
+        travaux = LotSynchronisation::lireManifeste(manifeste);
     } catch (const exception &e) {
         cerr << "[Erreur] " << e.what() << endl;
-        return false;
+        return {};
     }
+
+    return genererLot(travaux);
 }
@@ -0,0 +1,69 @@
+/**
+ * @file TamponCirculaire.cpp
+ * @brief Implémentation du tampon circulaire de la lecture en flux.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/TamponCirculaire.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+
+TamponCirculaire::TamponCirculaire(size_t capacite) : donnees(max<size_t>(capacite, 1)) {
+}
+
+void TamponCirculaire::reinitialiser(int64_t position) {
+    debut = position;
+    fin = position;
+}
+
+int64_t TamponCirculaire::obtenirDebut() const {
+    return debut;
+}
+
+int64_t TamponCirculaire::obtenirFin() const {
+    return fin;
+}
+
+span<float> TamponCirculaire::zoneEcriture() {
+    const auto capacite = static_cast<int64_t>(donnees.size());
+    const int64_t libre = capacite - (fin - debut);
+    const int64_t indice = fin % capacite;
+
+    // La zone s'arrête au bout du stockage : l'écriture suivante repartira du début.
+    return {donnees.data() + indice, static_cast<size_t>(min(libre, capacite - indice))};
+}
+
+void TamponCirculaire::valider(size_t n) {
+    if (fin - debut + static_cast<int64_t>(n) > static_cast<int64_t>(donnees.size())) {
+        throw logic_error("Dépassement de capacité du tampon circulaire.");
+    }
+
+    fin += static_cast<int64_t>(n);
+}
+
+void TamponCirculaire::liberer(int64_t position) {
+    debut = clamp(position, debut, fin);
+}
+
+void TamponCirculaire::copier(int64_t position, span<float> destination) const {
+    const auto capacite = static_cast<int64_t>(donnees.size());
+
+    for (size_t i = 0; i < destination.size();) {
+        const int64_t p = position + static_cast<int64_t>(i);
+
+        if (p < debut || p >= fin) {
+            destination[i++] = 0.0f;
+            continue;
+        }
+
+        // Copie par tronçons contigus jusqu'à la fin des données ou du stockage.
+        const int64_t indice = p % capacite;
+        const auto longueur = static_cast<size_t>(min({fin - p, capacite - indice,
+                                                       static_cast<int64_t>(destination.size() - i)}));
+
+        copy_n(donnees.begin() + indice, longueur, destination.begin() + i);
+        i += longueur;
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * @file TransformeeFourier.cpp
+ * @brief Implémentation de la FFT radix-2 itérative utilisée par les moteurs de corrélation.
+ */
+
+#include "../include/ClassSynchroniseurMultiVideo/TransformeeFourier.h"
+
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+TransformeeFourier::TransformeeFourier(size_t tailleMinimale) {
+    if (tailleMinimale == 0 || tailleMinimale > (size_t{1} << 31)) {
+        throw invalid_argument("Taille de FFT invalide.");
+    }
+
+    taille = puissanceDeuxSuperieure(tailleMinimale);
+
+    // Facteurs de rotation de la transformée directe.
+    facteursRotation.resize(taille / 2);
+    for (size_t k = 0; k < taille / 2; ++k) {
+        const double angle = -2.0 * numbers::pi * static_cast<double>(k) / static_cast<double>(taille);
+        facteursRotation[k] = {cos(angle), sin(angle)};
+    }
+
+    // Permutation par inversion de bits, calculée incrémentalement.
+    inversionBits.resize(taille);
+    inversionBits[0] = 0;
+    for (size_t i = 1, j = 0; i < taille; ++i) {
+        size_t bit = taille >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        inversionBits[i] = static_cast<uint32_t>(j);
+    }
+}
+
+size_t TransformeeFourier::obtenirTaille() const {
+    return taille;
+}
+
+void TransformeeFourier::transformer(span<complex<double> > donnees, bool inverse) const {
+    if (donnees.size() != taille) throw invalid_argument("Taille du tampon incompatible avec le plan FFT.");
+
+    // Réordonne les échantillons (chaque paire n'est échangée qu'une fois).
+    for (size_t i = 0; i < taille; ++i) {
+        const size_t j = inversionBits[i];
+        if (i < j) swap(donnees[i], donnees[j]);
+    }
+
+    // Papillons de Cooley-Tukey, de la plus petite à la plus grande demi-longueur.
+    for (size_t longueur = 2; longueur <= taille; longueur <<= 1) {
+        const size_t moitie = longueur / 2;
+        const size_t saut = taille / longueur;
+
+        for (size_t debut = 0; debut < taille; debut += longueur) {
+            for (size_t k = 0; k < moitie; ++k) {
+                complex<double> w = facteursRotation[k * saut];
+                if (inverse) w = conj(w);
+
+                const complex<double> u = donnees[debut + k];
+                const complex<double> v = donnees[debut + k + moitie] * w;
+
+                donnees[debut + k] = u + v;
+                donnees[debut + k + moitie] = u - v;
+            }
+        }
+    }
+
+    if (inverse) {
+        const double facteur = 1.0 / static_cast<double>(taille);
+        for (auto &valeur: donnees) valeur *= facteur;
+    }
+}
+
+size_t TransformeeFourier::puissanceDeuxSuperieure(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
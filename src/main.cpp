@@ -1,17 +1,78 @@
 #include "../include/ClassSynchroniseurMultiVideo/SynchroniseurMultiVideo.h"
+#include <algorithm>
+#include <cstdlib>
 #include <vector>
 #include <string>
 
 using namespace std;
 
-int main() {
+int main(int argc, char *argv[]) {
     SynchroniseurMultiVideo synchro;
 
     // Configuration de l'analyse :
     // - Durée d'analyse : 60 secondes
     // - Plage de recherche : 30 secondes
-    // - Précision (pas) : 100 (plus petit = plus précis)
-    synchro.configurerAnalyse(60.0, 30.0, 100);
+    // - Précision (pas) : 100 (plus petit = plus précis, utilisé par la méthode directe)
+    // - Méthode : corrélation complète par FFT (exacte à l'échantillon près)
+    synchro.configurerAnalyse(60.0, 30.0, 100, MethodeCorrelation::FFT);
+
+    // Analyse des vidéos cibles en parallèle (0 = un thread par cœur disponible)
+    synchro.configurerParallelisme(0);
+
+    // Caméras démarrées à quelques secondes d'écart : recherche sur ±2 s, élargie si le pic n'est pas net
+    // synchro.configurerRechercheProgressive(true, 2.0, 12.0);
+
+    // Enregistrements longs : analyse en flux limitée à 512 Mo, sur deux fenêtres prises à 10 et 60 minutes
+    // synchro.configurerLectureFlux(512ull * 1024 * 1024, {600.0, 3600.0});
+
+    // Cache des signaux décodés : une nouvelle exécution sur les mêmes rushes ne décode plus l'audio
+    synchro.configurerCache(".cache_synchro");
+
+    // Rapport des temps et du travail de chaque étape (JSON), et trace visualisable dans chrome://tracing
+    // synchro.configurerMetriques("metriques.json", "trace.json");
+
+    // Angles qui recouvrent mal la référence : alignement de toutes les paires puis chronologie globale
+    // synchro.configurerAlignementGlobal(true);
+
+    // Enregistrements de plus d'une heure : suivi de la dérive d'horloge des caméras (fenêtres de 5 s toutes les 30 s)
+    // synchro.configurerDerive(true);
+
+    // Rendu de contrôle rapide (demi-résolution, 15 images/s) ; ProfilEncodage::archive() pour le master
+    // synchro.configurerEncodage(ProfilEncodage::apercu());
+
+    // Rendus longs : timeline découpée en segments encodés en parallèle (0 = un par cœur), assemblés sans réencodage
+    // synchro.configurerSegments(0);
+
+    // Décalages exportés pour le montage : fiche JSON (ou EDL avec l'extension .edl), sans encoder de vidéo
+    // synchro.configurerFicheSynchro("sortie_synchro.json", true);
+
+    // Tournage en cours : décalages publiés en continu depuis des fichiers en cours d'écriture (ou tubes, flux tcp://)
+    // synchro.suivreEnDirect("ref.ts", {"angle2.ts", "angle3.ts"}, [](size_t i, const ResultatDecalage &r) {
+    //     cout << "Angle " << i + 2 << " : " << r.decalage << " s (confiance " << r.confiance << ")" << endl;
+    //     return true;
+    // });
+
+    // Traitement par lots : ClassSynchroniseurMultiVideo --lot manifeste.txt [--analyses N] [--encodages N]
+    // Une ligne par vidéo à générer (voir LotSynchronisation::lireManifeste), par exemple :
+    //     concert.mp4 priorite=2 cam1.mp4 cam2.mp4 cam3.mp4
+    //     clip.mp4 audio=mix.wav cam1.mp4 cam2.mp4
+    // L'analyse des travaux suivants se poursuit pendant l'encodage des précédents, sur un seul pool de threads.
+    if (argc >= 3 && string(argv[1]) == "--lot") {
+        size_t analyses = 2, encodages = 1;
+
+        for (int i = 3; i + 1 < argc; i += 2) {
+            const string option = argv[i];
+            if (option == "--analyses") analyses = strtoul(argv[i + 1], nullptr, 10);
+            if (option == "--encodages") encodages = strtoul(argv[i + 1], nullptr, 10);
+        }
+
+        synchro.configurerLot(analyses, encodages);
+
+        const vector<bool> reussites = synchro.genererLot(argv[2]);
+        const bool tousReussis = !reussites.empty() && ranges::all_of(reussites, [](bool reussi) { return reussi; });
+
+        return tousReussis ? 0 : 1;
+    }
 
     // Option 1 : Utiliser une vidéo comme référence (ancienne méthode)
 